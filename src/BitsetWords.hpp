@@ -0,0 +1,333 @@
+#ifndef HYPERPLANEFINDER_BITSETWORDS_HPP
+#define HYPERPLANEFINDER_BITSETWORDS_HPP
+
+
+#include <array>
+#include <bitset>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// std::bitset storage is an array of words starting at its address, bit i being bit i % w of word i / w (w the
+// size of the words). On little endian targets this is bit i % 8 of byte i / 8 whatever w, so the words can be
+// copied with memcpy. Other targets go bit by bit.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#define HYPERPLANEFINDER_BITSET_BIT_BY_BIT
+#endif
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Number of 64 bits words of a bitset of @p N bits.
+	 */
+	template<size_t N>
+	constexpr size_t BITSET_WORDS = (N + 63) / 64;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Get the 64 bits words of a bitset, bit @c i of the bitset is
+	 *             bit @c i % 64 of word @c i / 64.
+	 *
+	 * @param[in]  bitset  The bitset
+	 *
+	 * @tparam     N       Number of bits of the bitset
+	 *
+	 * @return     The words of the bitset
+	 */
+	template<size_t N>
+	std::array<std::uint64_t, BITSET_WORDS<N>> toWords(const std::bitset<N>& bitset);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Make a bitset from its 64 bits words (see toWords()).
+	 *
+	 * @param[in]  words  The words, bits after the N th are ignored
+	 *
+	 * @tparam     N      Number of bits of the bitset
+	 *
+	 * @return     The bitset
+	 */
+	template<size_t N>
+	std::bitset<N> fromWords(const std::array<std::uint64_t, BITSET_WORDS<N>>& words);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Call @p function on the index of each set bit of @p bitset,
+	 *             in increasing order.
+	 *
+	 * @param[in]  bitset    The bitset
+	 * @param[in]  function  The function, called as function(index)
+	 *
+	 * @tparam     N         Number of bits of the bitset
+	 * @tparam     Function  Type of @p function
+	 */
+	template<size_t N, typename Function>
+	void forEachSetBit(const std::bitset<N>& bitset, const Function& function);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Get the index of the lowest set bit of a non null word.
+	 *
+	 * @param[in]  word  The word, must not be 0
+	 *
+	 * @return     The index of the lowest set bit
+	 */
+	inline unsigned int countTrailingZeros(std::uint64_t word);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Copy a bitset into a wider one, the bits after the N2 th
+	 *             being 0.
+	 *
+	 * @param[in]  bitset  The bitset
+	 *
+	 * @tparam     N1      Number of bits of the result, at least N2
+	 * @tparam     N2      Number of bits of @p bitset
+	 *
+	 * @return     The widened bitset
+	 */
+	template<size_t N1, size_t N2>
+	std::bitset<N1> copyBitset(const std::bitset<N2>& bitset);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Concatenate layers into one bitset: bit @c j of layer @c i
+	 *             is bit @c i * N + j of the result.
+	 *
+	 * @param[in]  layers     The layers
+	 *
+	 * @tparam     N          Number of bits of a layer
+	 * @tparam     NbrLayers  Number of layers
+	 *
+	 * @return     The concatenation of the layers
+	 */
+	template<size_t N, size_t NbrLayers>
+	std::bitset<N * NbrLayers> concatenateLayers(const std::array<std::bitset<N>, NbrLayers>& layers);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Split a bitset into layers, inverse of concatenateLayers().
+	 *
+	 * @param[in]  bitset     The bitset
+	 *
+	 * @tparam     N          Number of bits of a layer
+	 * @tparam     NbrLayers  Number of layers
+	 *
+	 * @return     The layers of the bitset
+	 */
+	template<size_t N, size_t NbrLayers>
+	std::array<std::bitset<N>, NbrLayers> splitLayers(const std::bitset<N * NbrLayers>& bitset);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Strict total order of bitsets, compared word by word as
+	 *             unsigned integers whose bit N - 1 is the most significant.
+	 *
+	 * @param[in]  x     The first bitset
+	 * @param[in]  y     The second bitset
+	 *
+	 * @tparam     N     Number of bits of the bitsets
+	 *
+	 * @return     True if @p x is before @p y
+	 */
+	template<size_t N>
+	bool bitsetLess(const std::bitset<N>& x, const std::bitset<N>& y) noexcept;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Function object of bitsetLess().
+	 */
+	template<size_t N>
+	struct BitsetLess {
+		bool operator()(const std::bitset<N>& x, const std::bitset<N>& y) const noexcept {
+			return bitsetLess(x, y);
+		}
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      64 bits hash of a bitset, computed from its words.
+	 *
+	 * @param[in]  bitset  The bitset
+	 *
+	 * @tparam     N       Number of bits of the bitset
+	 *
+	 * @return     The hash
+	 */
+	template<size_t N>
+	std::uint64_t hashBitset(const std::bitset<N>& bitset) noexcept;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Function object of hashBitset(), to be used instead of
+	 *             std::hash which hashes the bitsets byte by byte.
+	 */
+	template<size_t N>
+	struct BitsetHash {
+		size_t operator()(const std::bitset<N>& bitset) const noexcept {
+			return hashBitset(bitset);
+		}
+	};
+}
+
+// Implementations
+namespace segre {
+
+	template<size_t N>
+	std::array<std::uint64_t, BITSET_WORDS<N>> toWords(const std::bitset<N>& bitset) {
+		std::array<std::uint64_t, BITSET_WORDS<N>> words{};
+#ifndef HYPERPLANEFINDER_BITSET_BIT_BY_BIT
+		static_assert(sizeof(std::bitset<N>) * CHAR_BIT >= N, "Unexpected std::bitset storage");
+		std::memcpy(words.data(), &bitset, (N + CHAR_BIT - 1) / CHAR_BIT);
+		if constexpr (N % 64 != 0) {
+			// Padding bits of the last byte are unspecified
+			words[BITSET_WORDS<N> - 1] &= (std::uint64_t{1} << (N % 64)) - 1;
+		}
+#else
+		for (size_t i = 0; i < N; ++i) {
+			if (bitset[i]) {
+				words[i / 64] |= std::uint64_t{1} << (i % 64);
+			}
+		}
+#endif
+		return words;
+	}
+
+	template<size_t N>
+	std::bitset<N> fromWords(const std::array<std::uint64_t, BITSET_WORDS<N>>& words) {
+		std::bitset<N> bitset;
+#ifndef HYPERPLANEFINDER_BITSET_BIT_BY_BIT
+		static_assert(sizeof(std::bitset<N>) * CHAR_BIT >= N, "Unexpected std::bitset storage");
+		std::array<std::uint64_t, BITSET_WORDS<N>> masked_words = words;
+		if constexpr (N % 64 != 0) {
+			masked_words[BITSET_WORDS<N> - 1] &= (std::uint64_t{1} << (N % 64)) - 1;
+		}
+		std::memcpy(static_cast<void*>(&bitset), masked_words.data(), (N + CHAR_BIT - 1) / CHAR_BIT);
+#else
+		for (size_t i = 0; i < N; ++i) {
+			bitset[i] = ((words[i / 64] >> (i % 64)) & 1U) != 0;
+		}
+#endif
+		return bitset;
+	}
+
+	template<size_t N, typename Function>
+	void forEachSetBit(const std::bitset<N>& bitset, const Function& function) {
+		const std::array<std::uint64_t, BITSET_WORDS<N>> words = toWords(bitset);
+		for (size_t w = 0; w < BITSET_WORDS<N>; ++w) {
+			std::uint64_t word = words[w];
+			while (word != 0) {
+				function(w * 64 + countTrailingZeros(word));
+				word &= word - 1;
+			}
+		}
+	}
+
+	inline unsigned int countTrailingZeros(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+		return static_cast<unsigned int>(__builtin_ctzll(word));
+#else
+		unsigned int count = 0;
+		while ((word & 1U) == 0) {
+			word >>= 1U;
+			++count;
+		}
+		return count;
+#endif
+	}
+
+	namespace detail {
+
+		// Bits [offset, offset + N) of the words are set to the bits of a bitset of N bits, they must be 0 before.
+		// The offset is a multiple of N: layers of a multiple of 64 bits (64, 256, ...) are whole words and layers
+		// of a divisor of 64 bits (4, 16, ...) are in a single word.
+		template<size_t N, size_t NbrWords>
+		void writeLayerWords(std::array<std::uint64_t, NbrWords>& words, size_t offset, const std::array<std::uint64_t, BITSET_WORDS<N>>& layer) {
+			const size_t first = offset / 64;
+			const size_t shift = offset % 64;
+			if constexpr (N % 64 == 0) {
+				std::memcpy(words.data() + first, layer.data(), sizeof(layer));
+			}
+			else if constexpr (64 % N == 0) {
+				words[first] |= layer[0] << shift;
+			}
+			else {
+				for (size_t w = 0; w < BITSET_WORDS<N>; ++w) {
+					words[first + w] |= layer[w] << shift;
+					if (shift != 0 && first + w + 1 < NbrWords) {
+						words[first + w + 1] |= layer[w] >> (64 - shift);
+					}
+				}
+			}
+		}
+
+		// Bits [offset, offset + N) of the words, the bits after the N th of the result are unspecified.
+		template<size_t N, size_t NbrWords>
+		std::array<std::uint64_t, BITSET_WORDS<N>> readLayerWords(const std::array<std::uint64_t, NbrWords>& words, size_t offset) {
+			const size_t first = offset / 64;
+			const size_t shift = offset % 64;
+			std::array<std::uint64_t, BITSET_WORDS<N>> layer{};
+			if constexpr (N % 64 == 0) {
+				std::memcpy(layer.data(), words.data() + first, sizeof(layer));
+			}
+			else if constexpr (64 % N == 0) {
+				layer[0] = words[first] >> shift;
+			}
+			else {
+				for (size_t w = 0; w < BITSET_WORDS<N>; ++w) {
+					layer[w] = words[first + w] >> shift;
+					if (shift != 0 && first + w + 1 < NbrWords) {
+						layer[w] |= words[first + w + 1] << (64 - shift);
+					}
+				}
+			}
+			return layer;
+		}
+	}
+
+	template<size_t N1, size_t N2>
+	std::bitset<N1> copyBitset(const std::bitset<N2>& bitset) {
+		static_assert(N1 >= N2, "copyBitset only widens bitsets");
+		std::array<std::uint64_t, BITSET_WORDS<N1>> words{};
+		detail::writeLayerWords<N2>(words, 0, toWords(bitset));
+		return fromWords<N1>(words);
+	}
+
+	template<size_t N, size_t NbrLayers>
+	std::bitset<N * NbrLayers> concatenateLayers(const std::array<std::bitset<N>, NbrLayers>& layers) {
+		std::array<std::uint64_t, BITSET_WORDS<N * NbrLayers>> words{};
+		for (size_t i = 0; i < NbrLayers; ++i) {
+			detail::writeLayerWords<N>(words, i * N, toWords(layers[i]));
+		}
+		return fromWords<N * NbrLayers>(words);
+	}
+
+	template<size_t N, size_t NbrLayers>
+	std::array<std::bitset<N>, NbrLayers> splitLayers(const std::bitset<N * NbrLayers>& bitset) {
+		const std::array<std::uint64_t, BITSET_WORDS<N * NbrLayers>> words = toWords(bitset);
+		std::array<std::bitset<N>, NbrLayers> layers;
+		for (size_t i = 0; i < NbrLayers; ++i) {
+			layers[i] = fromWords<N>(detail::readLayerWords<N>(words, i * N));
+		}
+		return layers;
+	}
+
+	template<size_t N>
+	bool bitsetLess(const std::bitset<N>& x, const std::bitset<N>& y) noexcept {
+		const std::array<std::uint64_t, BITSET_WORDS<N>> x_words = toWords(x);
+		const std::array<std::uint64_t, BITSET_WORDS<N>> y_words = toWords(y);
+		for (size_t w = BITSET_WORDS<N>; w-- > 0;) {
+			if (x_words[w] != y_words[w]) {
+				return x_words[w] < y_words[w];
+			}
+		}
+		return false;
+	}
+
+	template<size_t N>
+	std::uint64_t hashBitset(const std::bitset<N>& bitset) noexcept {
+		std::uint64_t hash = N;
+		for (std::uint64_t word : toWords(bitset)) {
+			hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+			hash ^= hash >> 32U;
+		}
+		// splitmix64 finalizer, the low bits select the buckets
+		hash = (hash ^ (hash >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+		hash = (hash ^ (hash >> 27U)) * 0x94d049bb133111ebULL;
+		return hash ^ (hash >> 31U);
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_BITSETWORDS_HPP
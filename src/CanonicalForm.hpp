@@ -0,0 +1,352 @@
+#ifndef HYPERPLANEFINDER_CANONICALFORM_HPP
+#define HYPERPLANEFINDER_CANONICALFORM_HPP
+
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "BitsetWords.hpp"
+#include "ConcurrentCache.hpp"
+#include "FlatHashMap.hpp"
+#include "PermutationGenerator.hpp"
+#include "math.hpp"
+#include "impossible.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Canonical form of a Veldkamp line: its hyperplanes, images
+	 *             of the line hyperplanes by the canonical permutation, in the
+	 *             canonical order.
+	 */
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	using CanonicalVeldkampLine = std::array<std::bitset<NbrPoints>, NbrPointsPerLine>;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Hash function object of CanonicalVeldkampLine.
+	 */
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	struct CanonicalVeldkampLineHash {
+		size_t operator()(const CanonicalVeldkampLine<NbrPointsPerLine, NbrPoints>& line) const;
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Cache of hyperplanes canonical forms.
+	 */
+	template<size_t NbrPoints>
+	using CanonicalHyperplanesCache = ConcurrentCache<std::bitset<NbrPoints>, std::bitset<NbrPoints>, BitsetHash<NbrPoints>>;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates the canonical form of an hyperplane: its minimal
+	 *             image by the permutations of the geometry.
+	 *
+	 * @details    Two hyperplanes have the same canonical form if and only if
+	 *             a permutation sends one to the other. The images are compared
+	 *             point by point in the order the search determines them (see
+	 *             detail::CanonicalSearch), a point out of the hyperplane being
+	 *             smaller than a point in it.
+	 *
+	 * @param[in]  hyperplane        The hyperplane
+	 *
+	 * @tparam     Dimension         Dimension of the geometry
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     NbrPoints         Number of points of the geometry
+	 *
+	 * @return     The canonical form of @p hyperplane
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::bitset<NbrPoints> computeCanonicalHyperplane(const std::bitset<NbrPoints>& hyperplane);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates the canonical form of an hyperplane, memoized in
+	 *             @p cache.
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::bitset<NbrPoints> computeCanonicalHyperplane(const std::bitset<NbrPoints>& hyperplane, CanonicalHyperplanesCache<NbrPoints>& cache);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates the canonical form of a Veldkamp line.
+	 *
+	 * @details    The line is seen as a coloring of the points: the core, and
+	 *             for each other point the line hyperplane containing it. The
+	 *             hyperplanes colors are numbered by order of appearance, so
+	 *             the canonical form doesn't depend on the hyperplanes order.
+	 *             Two lines have the same canonical form if and only if a
+	 *             permutation sends one to the other.
+	 *
+	 * @param[in]  line              The line, as ids in @p hyperplanes
+	 * @param[in]  hyperplanes       The hyperplanes
+	 *
+	 * @tparam     Dimension         Dimension of the geometry
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     NbrPoints         Number of points of the geometry
+	 *
+	 * @return     The canonical form of @p line
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	CanonicalVeldkampLine<NbrPointsPerLine, NbrPoints> computeCanonicalVeldkampLine(const std::array<unsigned int, NbrPointsPerLine>& line, const std::vector<std::bitset<NbrPoints>>& hyperplanes);
+}
+
+namespace segre::detail {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Branch and bound search of the minimal image of a points
+	 *             coloring by the permutations of the geometry.
+	 *
+	 * @details    The permutations are enumerated as in StabilizerSearch:
+	 *             dimensions permutation first, then the coordinates
+	 *             permutations value by value, all dimensions for each value.
+	 *             The color of an image point is known as soon as all its
+	 *             coordinates are assigned, the image points are compared in
+	 *             that order and a branch is cut as soon as its image is
+	 *             greater than the best one found.
+	 *
+	 *             Colors below the fixed colors number are kept as is, the
+	 *             others are renumbered by order of appearance.
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	class CanonicalSearch {
+
+	public:
+
+		static constexpr size_t MAX_COLORS = 16;
+
+		CanonicalSearch(const std::array<std::uint8_t, NbrPoints>& colors, std::uint8_t nbr_fixed_colors)
+		  : m_colors(colors)
+		  , m_nbr_fixed_colors(nbr_fixed_colors)
+		  , m_order()
+		  , m_step_begins()
+		  , m_current()
+		  , m_best()
+		  , m_common(0)
+		  , m_relabel()
+		  , m_next_label(nbr_fixed_colors)
+		  , m_coord_permutations()
+		  , m_used_coords()
+		  , m_dimension_permutation()
+		  , m_dimension_weights() {
+
+			// A point is known once its last coordinate is assigned, at step max(c_i * Dimension + i)
+			std::array<size_t, NbrPoints> steps;
+			for(unsigned int point = 0; point < NbrPoints; ++point) {
+				unsigned int remaining = point;
+				steps[point] = 0;
+				for(size_t i = 0; i < Dimension; ++i) {
+					steps[point] = std::max(steps[point], (remaining % NbrPointsPerLine) * Dimension + i);
+					remaining /= NbrPointsPerLine;
+				}
+			}
+			size_t position = 0;
+			for(size_t step = 0; step < NBR_STEPS; ++step) {
+				m_step_begins[step] = position;
+				for(unsigned int point = 0; point < NbrPoints; ++point) {
+					if(steps[point] == step) {
+						m_order[position++] = point;
+					}
+				}
+			}
+			m_step_begins[NBR_STEPS] = position;
+		}
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Calculates the minimal image.
+		 *
+		 * @return     The color of each point of the minimal image
+		 */
+		std::array<std::uint8_t, NbrPoints> compute() {
+			m_best.fill(std::numeric_limits<std::uint8_t>::max());
+			m_relabel.fill(NO_LABEL);
+
+			PermutationGenerator<Dimension> dimension_permutations_generator;
+			while(!dimension_permutations_generator.isFinished()) {
+				setDimensionPermutation(dimension_permutations_generator.nextPermutation());
+				m_common = 0;
+				search(0);
+			}
+
+			std::array<std::uint8_t, NbrPoints> image;
+			for(size_t position = 0; position < NbrPoints; ++position) {
+				image[m_order[position]] = m_best[position];
+			}
+			return image;
+		}
+
+	private:
+
+		static constexpr size_t NBR_STEPS = Dimension * NbrPointsPerLine;
+		static constexpr std::uint8_t NO_LABEL = std::numeric_limits<std::uint8_t>::max();
+
+		void setDimensionPermutation(const std::array<unsigned int, Dimension>& dimension_permutation) {
+			m_dimension_permutation = dimension_permutation;
+			for(size_t i = 0; i < Dimension; ++i) {
+				m_dimension_weights[i] = math::pow(static_cast<unsigned int>(NbrPointsPerLine), dimension_permutation[i]);
+			}
+			for(std::array<bool, NbrPointsPerLine>& used : m_used_coords) {
+				used.fill(false);
+			}
+		}
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Color the image points known at @p step.
+		 *
+		 * @return     False if the image is now greater than the best one
+		 */
+		bool extend(size_t step) {
+			for(size_t position = m_step_begins[step]; position < m_step_begins[step + 1]; ++position) {
+				unsigned int remaining = m_order[position];
+				unsigned int point = 0;
+				for(size_t i = 0; i < Dimension; ++i) {
+					point += m_coord_permutations[i][remaining % NbrPointsPerLine] * m_dimension_weights[i];
+					remaining /= NbrPointsPerLine;
+				}
+
+				std::uint8_t color = m_colors[point];
+				if(color >= m_nbr_fixed_colors) {
+					if(m_relabel[color] == NO_LABEL) {
+						m_relabel[color] = m_next_label++;
+					}
+					color = m_relabel[color];
+				}
+				m_current[position] = color;
+
+				// Compare only while the image is equal to the best one, once smaller it stays smaller
+				if(m_common == position) {
+					if(color > m_best[position]) {
+						return false;
+					}
+					if(color == m_best[position]) {
+						++m_common;
+					}
+				}
+			}
+			return true;
+		}
+
+		void search(size_t step) {
+			if(step == NBR_STEPS) {
+				m_best = m_current;
+				m_common = NbrPoints;
+				return;
+			}
+
+			const size_t dimension = step % Dimension;
+			const unsigned int coord = static_cast<unsigned int>(step / Dimension);
+			for(unsigned int value = 0; value < NbrPointsPerLine; ++value) {
+				if(m_used_coords[dimension][value]) {
+					continue;
+				}
+				m_coord_permutations[dimension][coord] = value;
+				m_used_coords[dimension][value] = true;
+				const std::array<std::uint8_t, MAX_COLORS> relabel = m_relabel;
+				const std::uint8_t next_label = m_next_label;
+
+				if(extend(step)) {
+					search(step + 1);
+				}
+
+				m_relabel = relabel;
+				m_next_label = next_label;
+				m_common = std::min(m_common, m_step_begins[step]);
+				m_used_coords[dimension][value] = false;
+			}
+		}
+
+		const std::array<std::uint8_t, NbrPoints> m_colors;
+		const std::uint8_t m_nbr_fixed_colors;
+		std::array<unsigned int, NbrPoints> m_order; ///< Image points in the order they are known
+		std::array<size_t, NBR_STEPS + 1> m_step_begins; ///< First position in m_order of each step
+		std::array<std::uint8_t, NbrPoints> m_current; ///< Colors of the current image, in m_order
+		std::array<std::uint8_t, NbrPoints> m_best; ///< Colors of the best image, in m_order
+		size_t m_common; ///< Length of the common prefix of m_current and m_best
+		std::array<std::uint8_t, MAX_COLORS> m_relabel;
+		std::uint8_t m_next_label;
+		std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension> m_coord_permutations;
+		std::array<std::array<bool, NbrPointsPerLine>, Dimension> m_used_coords;
+		std::array<unsigned int, Dimension> m_dimension_permutation;
+		std::array<unsigned int, Dimension> m_dimension_weights;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	size_t CanonicalVeldkampLineHash<NbrPointsPerLine, NbrPoints>::operator()(const CanonicalVeldkampLine<NbrPointsPerLine, NbrPoints>& line) const {
+		std::uint64_t hash = 0;
+		for(const std::bitset<NbrPoints>& hyperplane : line) {
+			hash = hashCombine(hash, hashBitset(hyperplane));
+		}
+		return hash;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	std::bitset<NbrPoints> computeCanonicalHyperplane(const std::bitset<NbrPoints>& hyperplane) {
+		std::array<std::uint8_t, NbrPoints> colors;
+		for(size_t point = 0; point < NbrPoints; ++point) {
+			colors[point] = hyperplane[point] ? 1 : 0;
+		}
+
+		const std::array<std::uint8_t, NbrPoints> image = detail::CanonicalSearch<Dimension, NbrPointsPerLine>(colors, 2).compute();
+		std::bitset<NbrPoints> canonical_hyperplane;
+		for(size_t point = 0; point < NbrPoints; ++point) {
+			canonical_hyperplane[point] = image[point] == 1;
+		}
+		return canonical_hyperplane;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	std::bitset<NbrPoints> computeCanonicalHyperplane(const std::bitset<NbrPoints>& hyperplane, CanonicalHyperplanesCache<NbrPoints>& cache) {
+		return cache.getOrCompute(hyperplane, [](const std::bitset<NbrPoints>& key) {
+			return computeCanonicalHyperplane<Dimension, NbrPointsPerLine>(key);
+		});
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	CanonicalVeldkampLine<NbrPointsPerLine, NbrPoints> computeCanonicalVeldkampLine(const std::array<unsigned int, NbrPointsPerLine>& line, const std::vector<std::bitset<NbrPoints>>& hyperplanes) {
+		static_assert(NbrPointsPerLine + 2 <= detail::CanonicalSearch<Dimension, NbrPointsPerLine>::MAX_COLORS, "Too many hyperplanes per line");
+		constexpr std::uint8_t CORE_COLOR = 0;
+		constexpr std::uint8_t NO_HYPERPLANE_COLOR = 1;
+		constexpr std::uint8_t FIRST_HYPERPLANE_COLOR = 2;
+
+		// Colors: core, no line hyperplane, or the only line hyperplane containing the point
+		std::array<std::uint8_t, NbrPoints> colors;
+		for(size_t point = 0; point < NbrPoints; ++point) {
+			size_t nbr_hyperplanes = 0;
+			for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+				if(hyperplanes[line[i]][point]) {
+					colors[point] = static_cast<std::uint8_t>(FIRST_HYPERPLANE_COLOR + i);
+					++nbr_hyperplanes;
+				}
+			}
+			if(nbr_hyperplanes == NbrPointsPerLine) {
+				colors[point] = CORE_COLOR;
+			}
+			else if(nbr_hyperplanes == 0) {
+				colors[point] = NO_HYPERPLANE_COLOR;
+			}
+			else if(nbr_hyperplanes != 1) {
+				// The hyperplanes of a Veldkamp line only meet on its core
+				IMPOSSIBLE;
+			}
+		}
+
+		const std::array<std::uint8_t, NbrPoints> image = detail::CanonicalSearch<Dimension, NbrPointsPerLine>(colors, FIRST_HYPERPLANE_COLOR).compute();
+		CanonicalVeldkampLine<NbrPointsPerLine, NbrPoints> canonical_line;
+		for(size_t point = 0; point < NbrPoints; ++point) {
+			for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+				canonical_line[i][point] = image[point] == CORE_COLOR || image[point] == FIRST_HYPERPLANE_COLOR + i;
+			}
+		}
+		return canonical_line;
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_CANONICALFORM_HPP
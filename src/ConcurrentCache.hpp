@@ -0,0 +1,117 @@
+#ifndef HYPERPLANEFINDER_CONCURRENTCACHE_HPP
+#define HYPERPLANEFINDER_CONCURRENTCACHE_HPP
+
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+#include "FlatHashMap.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Memoization cache usable from several threads.
+	 *
+	 * @details    The keys are spread over @p NbrShards FlatHashMap, each
+	 *             behind its own mutex. Values are computed outside of the
+	 *             locks: two threads missing the same key both compute it and
+	 *             the first inserted value is kept, so the computation must be
+	 *             deterministic.
+	 *
+	 * @tparam     Key        Type of the keys
+	 * @tparam     Value      Type of the values
+	 * @tparam     Hash       Hash function object of the keys
+	 * @tparam     NbrShards  Number of shards
+	 */
+	template<typename Key, typename Value, typename Hash = std::hash<Key>, size_t NbrShards = 64>
+	class ConcurrentCache {
+
+	public:
+
+		ConcurrentCache();
+
+		ConcurrentCache(const ConcurrentCache&) = delete;
+		ConcurrentCache& operator=(const ConcurrentCache&) = delete;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Get the value of a key, computing and storing it if it
+		 *             isn't in the cache.
+		 *
+		 * @param[in]  key      The key
+		 * @param[in]  compute  Function computing the value, called as
+		 *                      compute(key)
+		 *
+		 * @tparam     Compute  Type of @p compute
+		 *
+		 * @return     The value of @p key
+		 */
+		template<typename Compute>
+		Value getOrCompute(const Key& key, const Compute& compute);
+
+		size_t size() const;
+
+	private:
+
+		struct Shard {
+			Shard()
+			  : mutex()
+			  , values() {
+			}
+
+			mutable std::mutex mutex;
+			FlatHashMap<Key, Value, Hash> values;
+		};
+
+		Shard& getShard(const Key& key);
+
+		std::array<Shard, NbrShards> m_shards;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	template<typename Key, typename Value, typename Hash, size_t NbrShards>
+	ConcurrentCache<Key, Value, Hash, NbrShards>::ConcurrentCache()
+	  : m_shards() {
+
+	}
+
+	template<typename Key, typename Value, typename Hash, size_t NbrShards>
+	template<typename Compute>
+	Value ConcurrentCache<Key, Value, Hash, NbrShards>::getOrCompute(const Key& key, const Compute& compute) {
+		Shard& shard = getShard(key);
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			if(const Value* value = shard.values.find(key)) {
+				return *value;
+			}
+		}
+
+		const Value value = compute(key);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		return *shard.values.insert(key, value).first;
+	}
+
+	template<typename Key, typename Value, typename Hash, size_t NbrShards>
+	size_t ConcurrentCache<Key, Value, Hash, NbrShards>::size() const {
+		size_t size = 0;
+		for(const Shard& shard : m_shards) {
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			size += shard.values.size();
+		}
+		return size;
+	}
+
+	template<typename Key, typename Value, typename Hash, size_t NbrShards>
+	typename ConcurrentCache<Key, Value, Hash, NbrShards>::Shard& ConcurrentCache<Key, Value, Hash, NbrShards>::getShard(const Key& key) {
+		// The maps use the low bits of the hash, the shard is taken from the high ones
+		return m_shards[(hashCombine(0, Hash()(key)) >> 32U) % NbrShards];
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_CONCURRENTCACHE_HPP
@@ -0,0 +1,100 @@
+#ifndef HYPERPLANEFINDER_ENTRIESCOUNTER_HPP
+#define HYPERPLANEFINDER_ENTRIESCOUNTER_HPP
+
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "FlatHashMap.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Counts the occurrences of table entries, keeping the entries
+	 *             in the order they have been first added.
+	 *
+	 * @tparam     Entry  Type of the entries, hashable with std::hash
+	 */
+	template<typename Entry>
+	class EntriesCounter {
+
+	public:
+
+		EntriesCounter();
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Add occurrences of an entry.
+		 *
+		 * @param[in]  entry  The entry
+		 * @param[in]  count  The number of occurrences
+		 *
+		 * @return     The position of the entry
+		 */
+		size_t add(const Entry& entry, size_t count = 1);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Add the occurrences counted by another counter, the new
+		 *             entries of @p counter are put after the entries of this
+		 *             counter.
+		 *
+		 * @param[in]  counter  The other counter
+		 */
+		void merge(const EntriesCounter<Entry>& counter);
+
+		const std::vector<Entry>& getEntries() const;
+
+		const std::vector<size_t>& getCounts() const;
+
+	private:
+
+		std::vector<Entry> m_entries;
+		std::vector<size_t> m_counts;
+		FlatHashMap<Entry, size_t> m_positions;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	template<typename Entry>
+	EntriesCounter<Entry>::EntriesCounter()
+	  : m_entries()
+	  , m_counts()
+	  , m_positions() {
+
+	}
+
+	template<typename Entry>
+	size_t EntriesCounter<Entry>::add(const Entry& entry, size_t count) {
+		const std::pair<size_t*, bool> position = m_positions.insert(entry, m_entries.size());
+		if (position.second) {
+			m_entries.push_back(entry);
+			m_counts.push_back(count);
+		} else {
+			m_counts[*position.first] += count;
+		}
+		return *position.first;
+	}
+
+	template<typename Entry>
+	void EntriesCounter<Entry>::merge(const EntriesCounter<Entry>& counter) {
+		for (size_t i = 0; i < counter.m_entries.size(); ++i) {
+			add(counter.m_entries[i], counter.m_counts[i]);
+		}
+	}
+
+	template<typename Entry>
+	const std::vector<Entry>& EntriesCounter<Entry>::getEntries() const {
+		return m_entries;
+	}
+
+	template<typename Entry>
+	const std::vector<size_t>& EntriesCounter<Entry>::getCounts() const {
+		return m_counts;
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_ENTRIESCOUNTER_HPP
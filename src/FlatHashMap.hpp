@@ -0,0 +1,187 @@
+#ifndef HYPERPLANEFINDER_FLATHASHMAP_HPP
+#define HYPERPLANEFINDER_FLATHASHMAP_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Mix a value into an hash.
+	 *
+	 * @param[in]  seed   The current hash
+	 * @param[in]  value  The value to mix in
+	 *
+	 * @return     The new hash
+	 */
+	inline std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Open addressing hash map with linear probing.
+	 *
+	 * @details    Keys and values are stored inline in a single power of two
+	 *             sized slots array, which is grown when half full. There is
+	 *             no erase: the map is meant for aggregation, where entries are
+	 *             only inserted and looked up.
+	 *
+	 * @tparam     Key    Type of the keys
+	 * @tparam     Value  Type of the values
+	 * @tparam     Hash   Hash function object of the keys
+	 */
+	template<typename Key, typename Value, typename Hash = std::hash<Key>>
+	class FlatHashMap {
+
+	public:
+
+		explicit FlatHashMap(size_t expected_size = 0);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Find the value associated to a key.
+		 *
+		 * @param[in]  key   The key
+		 *
+		 * @return     A pointer to the value, nullptr if the key isn't in the map
+		 */
+		Value* find(const Key& key);
+
+		const Value* find(const Key& key) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Insert a key if it isn't already in the map.
+		 *
+		 * @param[in]  key    The key
+		 * @param[in]  value  The value associated to the key if it is inserted
+		 *
+		 * @return     A pointer to the value associated to the key and true if
+		 *             the key has been inserted, false if it was already in the
+		 *             map
+		 */
+		std::pair<Value*, bool> insert(const Key& key, const Value& value);
+
+		size_t size() const;
+
+	private:
+
+		struct Slot {
+			Slot()
+			  : used(false)
+			  , hash(0)
+			  , key()
+			  , value() {
+			}
+
+			bool used;
+			size_t hash;
+			Key key;
+			Value value;
+		};
+
+		size_t findSlot(const Key& key, size_t hash) const;
+
+		void grow();
+
+		std::vector<Slot> m_slots;
+		size_t m_size;
+		Hash m_hasher;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	inline std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value) {
+		// splitmix64 finalizer of the value, combined as in boost::hash_combine
+		value += 0x9e3779b97f4a7c15ULL;
+		value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+		value = (value ^ (value >> 27U)) * 0x94d049bb133111ebULL;
+		value ^= value >> 31U;
+		return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U));
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	FlatHashMap<Key, Value, Hash>::FlatHashMap(size_t expected_size)
+	  : m_slots()
+	  , m_size(0)
+	  , m_hasher() {
+
+		size_t capacity = 16;
+		while (capacity < 2 * expected_size) {
+			capacity *= 2;
+		}
+		m_slots.resize(capacity);
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	Value* FlatHashMap<Key, Value, Hash>::find(const Key& key) {
+		const size_t slot = findSlot(key, m_hasher(key));
+		return m_slots[slot].used ? &m_slots[slot].value : nullptr;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	const Value* FlatHashMap<Key, Value, Hash>::find(const Key& key) const {
+		const size_t slot = findSlot(key, m_hasher(key));
+		return m_slots[slot].used ? &m_slots[slot].value : nullptr;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	std::pair<Value*, bool> FlatHashMap<Key, Value, Hash>::insert(const Key& key, const Value& value) {
+		const size_t hash = m_hasher(key);
+		size_t slot = findSlot(key, hash);
+		if (m_slots[slot].used) {
+			return {&m_slots[slot].value, false};
+		}
+
+		if (2 * (m_size + 1) > m_slots.size()) {
+			grow();
+			slot = findSlot(key, hash);
+		}
+
+		m_slots[slot].used = true;
+		m_slots[slot].hash = hash;
+		m_slots[slot].key = key;
+		m_slots[slot].value = value;
+		++m_size;
+
+		return {&m_slots[slot].value, true};
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	size_t FlatHashMap<Key, Value, Hash>::size() const {
+		return m_size;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	size_t FlatHashMap<Key, Value, Hash>::findSlot(const Key& key, size_t hash) const {
+		const size_t mask = m_slots.size() - 1;
+		size_t slot = hash & mask;
+		while (m_slots[slot].used && (m_slots[slot].hash != hash || !(m_slots[slot].key == key))) {
+			slot = (slot + 1) & mask;
+		}
+		return slot;
+	}
+
+	template<typename Key, typename Value, typename Hash>
+	void FlatHashMap<Key, Value, Hash>::grow() {
+		std::vector<Slot> slots(2 * m_slots.size());
+		std::swap(slots, m_slots);
+
+		const size_t mask = m_slots.size() - 1;
+		for (Slot& old_slot : slots) {
+			if (old_slot.used) {
+				size_t slot = old_slot.hash & mask;
+				while (m_slots[slot].used) {
+					slot = (slot + 1) & mask;
+				}
+				m_slots[slot] = std::move(old_slot);
+			}
+		}
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_FLATHASHMAP_HPP
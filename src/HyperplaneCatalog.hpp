@@ -0,0 +1,272 @@
+#ifndef HYPERPLANEFINDER_HYPERPLANECATALOG_HPP
+#define HYPERPLANEFINDER_HYPERPLANECATALOG_HPP
+
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BitsetWords.hpp"
+#include "impossible.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HYPERPLANEFINDER_HAS_MMAP
+#endif
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Hyperplanes stored in a file and read on demand.
+	 *
+	 * @details    The file is a 32 bytes header (magic, number of points,
+	 *             hyperplanes number) followed by the words of the hyperplanes
+	 *             (see toWords()) in native endianness. It is memory mapped
+	 *             when the platform allows it and read with a stream
+	 *             otherwise, the hyperplanes are never all loaded in memory.
+	 *
+	 *             Reading is thread safe.
+	 *
+	 * @tparam     NbrPoints  Number of points of the geometry
+	 */
+	template<size_t NbrPoints>
+	class HyperplaneCatalog {
+
+	public:
+
+		HyperplaneCatalog() noexcept;
+
+		HyperplaneCatalog(const HyperplaneCatalog<NbrPoints>&) = delete;
+		HyperplaneCatalog<NbrPoints>& operator=(const HyperplaneCatalog<NbrPoints>&) = delete;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Write hyperplanes to a catalog file.
+		 *
+		 * @param[in]  path         The file path
+		 * @param[in]  hyperplanes  The hyperplanes, in the order of their ids
+		 *
+		 * @return     False and a message on std::cerr if the file couldn't be
+		 *             written
+		 */
+		static bool save(const std::string& path, const std::vector<std::bitset<NbrPoints>>& hyperplanes);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Open a catalog file, memory mapped if possible.
+		 *
+		 * @param[in]  path  The file path
+		 *
+		 * @return     False and a message on std::cerr if the file couldn't be
+		 *             read or doesn't hold hyperplanes of @p NbrPoints points,
+		 *             the catalog is then left unchanged
+		 */
+		bool open(const std::string& path);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Read the hyperplane of an id.
+		 */
+		std::bitset<NbrPoints> get(size_t id) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Read the hyperplanes of ids [@p first, @p first + @p
+		 *             count).
+		 *
+		 * @param[in]  first        The first id
+		 * @param[in]  count        The number of hyperplanes
+		 * @param[out] hyperplanes  The hyperplanes, resized to @p count
+		 */
+		void read(size_t first, size_t count, std::vector<std::bitset<NbrPoints>>& hyperplanes) const;
+
+		size_t size() const;
+
+		bool isMapped() const;
+
+	private:
+
+		using Words = std::array<std::uint64_t, BITSET_WORDS<NbrPoints>>;
+
+		static constexpr size_t HEADER_SIZE = 32;
+		static constexpr char MAGIC[8] = {'H', 'F', 'H', 'C', 'A', 'T', 'L', 'G'};
+
+		bool parseHeader(const char* header, const std::string& path, size_t file_size);
+
+		size_t m_size;
+		std::shared_ptr<const void> m_mapping; ///< Keeps the file mapping alive, null if not mapped
+		const char* m_data;
+		std::unique_ptr<std::ifstream> m_file; ///< Used when the file isn't mapped
+		std::unique_ptr<std::mutex> m_file_mutex;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	template<size_t NbrPoints>
+	HyperplaneCatalog<NbrPoints>::HyperplaneCatalog() noexcept
+	  : m_size(0)
+	  , m_mapping()
+	  , m_data(nullptr)
+	  , m_file()
+	  , m_file_mutex() {
+
+	}
+
+	template<size_t NbrPoints>
+	bool HyperplaneCatalog<NbrPoints>::save(const std::string& path, const std::vector<std::bitset<NbrPoints>>& hyperplanes) {
+		char header[HEADER_SIZE] = {};
+		const std::uint64_t nbr_points = NbrPoints;
+		const std::uint64_t nbr_hyperplanes = hyperplanes.size();
+		std::memcpy(header, MAGIC, sizeof(MAGIC));
+		std::memcpy(header + 8, &nbr_points, sizeof(nbr_points));
+		std::memcpy(header + 16, &nbr_hyperplanes, sizeof(nbr_hyperplanes));
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(header, HEADER_SIZE);
+		for(const std::bitset<NbrPoints>& hyperplane : hyperplanes) {
+			const Words words = toWords(hyperplane);
+			file.write(reinterpret_cast<const char*>(words.data()), sizeof(Words));
+		}
+		if(!file) {
+			std::cerr << "Failed to write hyperplanes catalog " << path << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	template<size_t NbrPoints>
+	bool HyperplaneCatalog<NbrPoints>::open(const std::string& path) {
+#ifdef HYPERPLANEFINDER_HAS_MMAP
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if(fd >= 0) {
+			struct stat file_stat;
+			void* mapping = MAP_FAILED;
+			size_t file_size = 0;
+			if(::fstat(fd, &file_stat) == 0 && file_stat.st_size >= static_cast<off_t>(HEADER_SIZE)) {
+				file_size = static_cast<size_t>(file_stat.st_size);
+				mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			}
+			::close(fd);
+
+			if(mapping != MAP_FAILED) {
+				std::shared_ptr<const void> holder(mapping, [file_size](const void* address) {
+					::munmap(const_cast<void*>(address), file_size);
+				});
+				if(!parseHeader(static_cast<const char*>(mapping), path, file_size)) {
+					return false;
+				}
+				// The catalog is read from the first to the last hyperplane by each block
+				::madvise(mapping, file_size, MADV_SEQUENTIAL);
+				m_file.reset();
+				m_file_mutex.reset();
+				m_mapping = std::move(holder);
+				m_data = static_cast<const char*>(mapping) + HEADER_SIZE;
+				return true;
+			}
+		}
+		// Fall back to reading the file
+#endif
+		auto file = std::make_unique<std::ifstream>(path, std::ios::binary | std::ios::ate);
+		if(!*file) {
+			std::cerr << "Failed to open hyperplanes catalog " << path << std::endl;
+			return false;
+		}
+		const size_t file_size = static_cast<size_t>(file->tellg());
+		file->seekg(0);
+		char header[HEADER_SIZE] = {};
+		if(!file->read(header, HEADER_SIZE)) {
+			std::cerr << "Failed to read hyperplanes catalog " << path << std::endl;
+			return false;
+		}
+		if(!parseHeader(header, path, file_size)) {
+			return false;
+		}
+		m_mapping.reset();
+		m_data = nullptr;
+		m_file = std::move(file);
+		m_file_mutex = std::make_unique<std::mutex>();
+		return true;
+	}
+
+	template<size_t NbrPoints>
+	std::bitset<NbrPoints> HyperplaneCatalog<NbrPoints>::get(size_t id) const {
+		if(m_data != nullptr) {
+			Words words;
+			std::memcpy(words.data(), m_data + id * sizeof(Words), sizeof(Words));
+			return fromWords<NbrPoints>(words);
+		}
+
+		std::vector<std::bitset<NbrPoints>> hyperplanes;
+		read(id, 1, hyperplanes);
+		return hyperplanes[0];
+	}
+
+	template<size_t NbrPoints>
+	void HyperplaneCatalog<NbrPoints>::read(size_t first, size_t count, std::vector<std::bitset<NbrPoints>>& hyperplanes) const {
+		hyperplanes.resize(count);
+		if(m_data != nullptr) {
+			Words words;
+			for(size_t i = 0; i < count; ++i) {
+				std::memcpy(words.data(), m_data + (first + i) * sizeof(Words), sizeof(Words));
+				hyperplanes[i] = fromWords<NbrPoints>(words);
+			}
+			return;
+		}
+
+		std::vector<Words> words(count);
+		{
+			std::lock_guard<std::mutex> lock(*m_file_mutex);
+			m_file->seekg(static_cast<std::streamoff>(HEADER_SIZE + first * sizeof(Words)));
+			m_file->read(reinterpret_cast<char*>(words.data()), static_cast<std::streamsize>(count * sizeof(Words)));
+			if(!*m_file) {
+				// The size of the file was checked on opening
+				IMPOSSIBLE;
+			}
+		}
+		for(size_t i = 0; i < count; ++i) {
+			hyperplanes[i] = fromWords<NbrPoints>(words[i]);
+		}
+	}
+
+	template<size_t NbrPoints>
+	size_t HyperplaneCatalog<NbrPoints>::size() const {
+		return m_size;
+	}
+
+	template<size_t NbrPoints>
+	bool HyperplaneCatalog<NbrPoints>::isMapped() const {
+		return m_mapping != nullptr;
+	}
+
+	template<size_t NbrPoints>
+	bool HyperplaneCatalog<NbrPoints>::parseHeader(const char* header, const std::string& path, size_t file_size) {
+		std::uint64_t nbr_points;
+		std::uint64_t nbr_hyperplanes;
+		std::memcpy(&nbr_points, header + 8, sizeof(nbr_points));
+		std::memcpy(&nbr_hyperplanes, header + 16, sizeof(nbr_hyperplanes));
+
+		if(std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0
+		   || nbr_points != NbrPoints
+		   || nbr_hyperplanes > (file_size - HEADER_SIZE) / sizeof(Words) // The size below doesn't overflow
+		   || file_size != HEADER_SIZE + nbr_hyperplanes * sizeof(Words)) {
+			std::cerr << "Invalid hyperplanes catalog " << path << std::endl;
+			return false;
+		}
+
+		m_size = nbr_hyperplanes;
+		return true;
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_HYPERPLANECATALOG_HPP
@@ -0,0 +1,60 @@
+#ifndef HYPERPLANEFINDER_HYPERPLANEINDEX_HPP
+#define HYPERPLANEFINDER_HYPERPLANEINDEX_HPP
+
+
+#include <bitset>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "BitsetWords.hpp"
+
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Hash index from an hyperplane to its id (its index in the
+	 *             hyperplanes vector it has been built from).
+	 *
+	 * @tparam     NbrPoints  Number of points of the geometry
+	 */
+	template<size_t NbrPoints>
+	class HyperplaneIndex {
+
+	public:
+
+		static constexpr unsigned int NOT_FOUND = std::numeric_limits<unsigned int>::max();
+
+		explicit HyperplaneIndex(const std::vector<std::bitset<NbrPoints>>& hyperplanes)
+		  : m_index() {
+
+			m_index.reserve(hyperplanes.size());
+			for(unsigned int i = 0; i < hyperplanes.size(); ++i) {
+				m_index.emplace(hyperplanes[i], i);
+			}
+		}
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Find the id of an hyperplane.
+		 *
+		 * @param[in]  hyperplane  The hyperplane
+		 *
+		 * @return     The id of the hyperplane, NOT_FOUND if the hyperplane
+		 *             isn't indexed
+		 */
+		unsigned int find(const std::bitset<NbrPoints>& hyperplane) const {
+			const typename std::unordered_map<std::bitset<NbrPoints>, unsigned int, BitsetHash<NbrPoints>>::const_iterator it = m_index.find(hyperplane);
+			return it == m_index.cend() ? NOT_FOUND : it->second;
+		}
+
+		size_t size() const {
+			return m_index.size();
+		}
+
+	private:
+
+		std::unordered_map<std::bitset<NbrPoints>, unsigned int, BitsetHash<NbrPoints>> m_index;
+	};
+}
+
+
+#endif //HYPERPLANEFINDER_HYPERPLANEINDEX_HPP
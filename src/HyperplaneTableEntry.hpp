@@ -3,11 +3,18 @@
 
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <vector>
 #include <set>
 
+#include "FlatHashMap.hpp"
+
 namespace segre{
 
 	struct HyperplaneTableEntry {
@@ -68,6 +75,151 @@ namespace segre{
 		size_t count;
 	};
 
+	/**
+	 * Fixed size form of an HyperplaneTableEntry (without its count), computed for every hyperplane without
+	 * any allocation and used as the key to aggregate the entries.
+	 *
+	 * The points of order k are counted in pointsOfOrder[k]: a point is at most on Dimension lines. The
+	 * subgeometries of a direction are the types of its NbrPointsPerLine slices (FULL for a full slice), sorted,
+	 * and the directions are sorted too (see sortSubgeometries()) so that equal entries have equal members.
+	 */
+	template <size_t Dimension, size_t NbrPointsPerLine>
+	struct FlatHyperplaneTableEntry {
+		static constexpr std::uint32_t FULL = std::numeric_limits<std::uint32_t>::max();
+
+		FlatHyperplaneTableEntry()
+		  : nbrPoints{0}
+		  , nbrLines{0}
+		  , hasSubgeometries{false}
+		  , pointsOfOrder{}
+		  , subgeometries{} {
+		}
+
+		/**
+		 * Puts the subgeometries in their canonical order.
+		 */
+		void sortSubgeometries() {
+			for (std::array<std::uint32_t, NbrPointsPerLine>& types : subgeometries) {
+				std::sort(types.begin(), types.end());
+			}
+			// Directions with a full sub geometry first
+			std::sort(subgeometries.begin(), subgeometries.end(), std::greater<std::array<std::uint32_t, NbrPointsPerLine>>());
+		}
+
+		/**
+		 * Converts back the entry to the table entry used by the printers.
+		 *
+		 * @param count the number of hyperplanes of the entry.
+		 * @return the table entry.
+		 */
+		HyperplaneTableEntry toTableEntry(size_t count) const {
+			HyperplaneTableEntry entry;
+			entry.nbrPoints = nbrPoints;
+			entry.nbrLines = nbrLines;
+
+			for (unsigned int order = 0; order <= Dimension; ++order) {
+				if (pointsOfOrder[order] != 0) {
+					entry.pointsOfOrder[order] = pointsOfOrder[order];
+				}
+			}
+
+			if (hasSubgeometries) {
+				entry.subgeometries.resize(Dimension);
+				for (size_t direction = 0; direction < Dimension; ++direction) {
+					for (std::uint32_t type : subgeometries[direction]) {
+						++(entry.subgeometries[direction][type == FULL ? -1 : static_cast<long long int>(type)]);
+					}
+				}
+			}
+
+			entry.count = count;
+			return entry;
+		}
+
+		bool operator==(const FlatHyperplaneTableEntry& entry) const {
+			return nbrPoints == entry.nbrPoints
+			       && nbrLines == entry.nbrLines
+			       && hasSubgeometries == entry.hasSubgeometries
+			       && pointsOfOrder == entry.pointsOfOrder
+			       && subgeometries == entry.subgeometries;
+		}
+
+		std::uint64_t hash() const {
+			std::uint64_t hash = hashCombine(nbrPoints, nbrLines);
+			for (unsigned int count : pointsOfOrder) {
+				hash = hashCombine(hash, count);
+			}
+			for (const std::array<std::uint32_t, NbrPointsPerLine>& types : subgeometries) {
+				for (std::uint32_t type : types) {
+					hash = hashCombine(hash, type);
+				}
+			}
+			return hash;
+		}
+
+		unsigned int nbrPoints;
+		unsigned int nbrLines;
+		bool hasSubgeometries;
+		std::array<unsigned int, Dimension + 1> pointsOfOrder;
+		std::array<std::array<std::uint32_t, NbrPointsPerLine>, Dimension> subgeometries;
+	};
+
+	/**
+	 * Hyperplanes table of a geometry, with the type of each hyperplane: the index of its entry in the table.
+	 */
+	struct HyperplanesTable {
+		HyperplanesTable()
+		  : entries{}
+		  , types{} {
+		}
+
+		std::vector<HyperplaneTableEntry> entries;
+		std::vector<unsigned int> types;
+	};
+
+	/**
+	 * Sorts the entries of an hyperplanes table (stable sort), the types of the hyperplanes are left unchanged.
+	 *
+	 * @param table the hyperplanes table.
+	 * @param compare the comparison function of the entries.
+	 * @return the new index of each entry, to update types.
+	 */
+	template <typename Compare>
+	std::vector<unsigned int> sortHyperplanesTableEntries(HyperplanesTable& table, Compare compare) {
+		std::vector<unsigned int> order(table.entries.size());
+		for (unsigned int i = 0; i < order.size(); ++i) {
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(), [&table, &compare](unsigned int a, unsigned int b) {
+			return compare(table.entries[a], table.entries[b]);
+		});
+
+		std::vector<HyperplaneTableEntry> entries;
+		entries.reserve(table.entries.size());
+		std::vector<unsigned int> new_types(table.entries.size());
+		for (unsigned int i = 0; i < order.size(); ++i) {
+			entries.push_back(std::move(table.entries[order[i]]));
+			new_types[order[i]] = i;
+		}
+
+		table.entries = std::move(entries);
+		return new_types;
+	}
+
+	/**
+	 * Sorts the entries of an hyperplanes table (stable sort), the types of the hyperplanes are updated.
+	 *
+	 * @param table the hyperplanes table.
+	 * @param compare the comparison function of the entries.
+	 */
+	template <typename Compare>
+	void sortHyperplanesTable(HyperplanesTable& table, Compare compare) {
+		const std::vector<unsigned int> new_types = sortHyperplanesTableEntries(table, compare);
+		for (unsigned int& type : table.types) {
+			type = new_types[type];
+		}
+	}
+
 	inline std::ostream& operator<<(std::ostream& os, const HyperplaneTableEntry& entry) {
 		os << "HyperplaneTableEntry{"
 		   << "Ps: " << entry.nbrPoints
@@ -123,5 +275,14 @@ namespace segre{
 	}
 }
 
+namespace std {
+	template <size_t Dimension, size_t NbrPointsPerLine>
+	struct hash<segre::FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>> {
+		size_t operator()(const segre::FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>& entry) const noexcept {
+			return static_cast<size_t>(entry.hash());
+		}
+	};
+}
+
 
 #endif //HYPERPLANEFINDER_HYPERPLANETABLEENTRY_HPP
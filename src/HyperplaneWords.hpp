@@ -0,0 +1,95 @@
+#ifndef HYPERPLANEFINDER_HYPERPLANEWORDS_HPP
+#define HYPERPLANEFINDER_HYPERPLANEWORDS_HPP
+
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "BitsetWords.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Word-major copy of hyperplanes (structure of arrays).
+	 *
+	 * @details    Word @c w of all the hyperplanes are contiguous (see
+	 *             toWords()), so that a loop over the hyperplanes reads
+	 *             consecutive words and vectorizes: a SIMD load covers several
+	 *             hyperplanes.
+	 *
+	 *             The columns are padded to a multiple of PADDING hyperplanes
+	 *             with full words, which don't match any core of two distinct
+	 *             hyperplanes.
+	 *
+	 * @tparam     NbrPoints  Number of points of the geometry
+	 */
+	template<size_t NbrPoints>
+	class HyperplaneWords {
+
+	public:
+
+		static constexpr size_t WORDS = BITSET_WORDS<NbrPoints>;
+		static constexpr size_t PADDING = 64;
+
+		explicit HyperplaneWords(const std::vector<std::bitset<NbrPoints>>& hyperplanes);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Get the word @p word of all the hyperplanes.
+		 *
+		 * @return     Pointer to the word of the first hyperplane, followed by
+		 *             getPaddedSize() - 1 words
+		 */
+		const std::uint64_t* getColumn(size_t word) const;
+
+		size_t size() const;
+
+		size_t getPaddedSize() const;
+
+	private:
+
+		size_t m_size;
+		size_t m_padded_size;
+		std::vector<std::uint64_t> m_words;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	template<size_t NbrPoints>
+	HyperplaneWords<NbrPoints>::HyperplaneWords(const std::vector<std::bitset<NbrPoints>>& hyperplanes)
+	  : m_size(hyperplanes.size())
+	  , m_padded_size((hyperplanes.size() + PADDING - 1) / PADDING * PADDING)
+	  , m_words(WORDS * m_padded_size, std::numeric_limits<std::uint64_t>::max()) {
+
+		for(size_t i = 0; i < m_size; ++i) {
+			const std::array<std::uint64_t, WORDS> words = toWords(hyperplanes[i]);
+			for(size_t w = 0; w < WORDS; ++w) {
+				m_words[w * m_padded_size + i] = words[w];
+			}
+		}
+	}
+
+	template<size_t NbrPoints>
+	const std::uint64_t* HyperplaneWords<NbrPoints>::getColumn(size_t word) const {
+		return m_words.data() + word * m_padded_size;
+	}
+
+	template<size_t NbrPoints>
+	size_t HyperplaneWords<NbrPoints>::size() const {
+		return m_size;
+	}
+
+	template<size_t NbrPoints>
+	size_t HyperplaneWords<NbrPoints>::getPaddedSize() const {
+		return m_padded_size;
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_HYPERPLANEWORDS_HPP
@@ -7,6 +7,11 @@
 #include <tuple>
 
 #include "PermutationGenerator.hpp"
+#include "HyperplaneIndex.hpp"
+#include "ParallelFor.hpp"
+#include "PermutationTable.hpp"
+#include "PointPermutation.hpp"
+#include "StabilizerSearch.hpp"
 #include "index_repetition.hpp"
 #include "math.hpp"
 #include "impossible.hpp"
@@ -199,6 +204,66 @@ namespace segre {
 	template<size_t Dimension, size_t NbrPointsPerLine>
 	std::vector<unsigned int> applyDimensionPermutation(const std::vector<unsigned int>& hyperplane, const std::array<unsigned int, Dimension>& permutation);
 
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compile a permutation to the image of each point of the
+	 *             geometry.
+	 *
+	 * @details    The coordinate @c i of each point is permuted by @p
+	 *             coord_permutations[@c i], then moved to the dimension @p
+	 *             dimension_permutation[@c i], as done by applyPermutation().
+	 *
+	 * @param[in]  coord_permutations     The coordinates permutations
+	 * @param[in]  dimension_permutation  The dimensions permutation
+	 *
+	 * @tparam     Dimension              Dimension of the geometry
+	 * @tparam     NbrPointsPerLine       Number of points per lines of the
+	 *                                    geometry
+	 * @tparam     NbrPoints              Number of points of the geometry
+	 *
+	 * @return     The compiled permutation
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	PointPermutation<NbrPoints> compilePermutation(const std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>& coord_permutations, const std::array<unsigned int, Dimension>& dimension_permutation);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compile all the permutations generated by
+	 *             makeMultiPermutationsGenerator(), in the generator order.
+	 *
+	 * @tparam     Dimension         Dimension of the geometry
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     NbrPoints         Number of points of the geometry
+	 *
+	 * @return     The compiled permutations
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::vector<PointPermutation<NbrPoints>> compileMultiPermutations();
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compile all the permutations generated by
+	 *             makeCoordPermutationsGenerator(), in the generator order.
+	 *
+	 * @tparam     Dimension         Dimension of the geometry
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     NbrPoints         Number of points of the geometry
+	 *
+	 * @return     The compiled permutations
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::vector<PointPermutation<NbrPoints>> compileCoordPermutations();
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compile all the permutations generated by
+	 *             PermutationGenerator\<@p Dimension\>, in the generator order.
+	 *
+	 * @tparam     Dimension         Dimension of the geometry
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     NbrPoints         Number of points of the geometry
+	 *
+	 * @return     The compiled permutations
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::vector<PointPermutation<NbrPoints>> compileDimensionPermutations();
+
 	/*------------------------------------------------------------------------*//**
 	 * @brief      Calculates the hyperplane stabilisation permutations.
 	 *
@@ -206,6 +271,11 @@ namespace segre {
 	 *             permutations that doesn't modify the hyperplane, the
 	 *             hyperplane stay the same on permutation application.
 	 *
+	 *             The permutations are found by a backtracking search checking
+	 *             each point as soon as its image is known (see
+	 *             detail::StabilizerSearch), they aren't in the
+	 *             makeMultiPermutationsGenerator() order.
+	 *
 	 * @param[in]  hyperplane        The hyperplane
 	 *
 	 * @tparam     Dimension         Dimension of the geometry
@@ -217,6 +287,25 @@ namespace segre {
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
 	std::vector<std::tuple<std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>, std::array<unsigned int, Dimension>>> computeHyperplaneStabilisationPermutations(std::bitset<NbrPoints> hyperplane);
 
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates generators and order of the stabilizer of an
+	 *             hyperplane.
+	 *
+	 * @details    Unlike computeHyperplaneStabilisationPermutations(), the
+	 *             stabilizer isn't enumerated: one permutation is searched per
+	 *             coset of its stabilizer chain (see detail::StabilizerSearch).
+	 *
+	 * @param[in]  hyperplane        The hyperplane
+	 *
+	 * @tparam     Dimension         Dimension of the geometry
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     NbrPoints         Number of points of the geometry
+	 *
+	 * @return     The stabilizer generators and order
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	HyperplaneStabilizer<Dimension, NbrPointsPerLine> computeHyperplaneStabilizer(const std::bitset<NbrPoints>& hyperplane);
+
 	/*------------------------------------------------------------------------*//**
 	 * @brief      Makes the permutations table, this table is the result of
 	 *             applying all possible permutation on each hyperplane of @p
@@ -227,16 +316,29 @@ namespace segre {
 	 *             applying permutation number @c m on hyperplane number @c n
 	 *             from the @p hyperplanes.
 	 *
+	 *             The rows are computed in parallel on @p Backend.
+	 *
 	 * @param[in]  hyperplanes       The hyperplanes to generate the table
+	 * @param[in]  index             The index of @p hyperplanes
 	 *
 	 * @tparam     Dimension         Dimension of the geometry
 	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     Backend           The parallel backend
+	 * @tparam     Id                Type of the hyperplanes ids, must hold
+	 *                               @p hyperplanes size
 	 * @tparam     NbrPoints         Number of points of the geometry
 	 *
-	 * @return     The permutations table
+	 * @return     The permutations table, row major
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
-	std::vector<std::vector<unsigned int>> makePermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes);
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, typename Id = std::uint32_t, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	PermutationTable<Id> makePermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes, const HyperplaneIndex<NbrPoints>& index);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Makes the permutations table of @p hyperplanes, building
+	 *             their index.
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, typename Id = std::uint32_t, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	PermutationTable<Id> makePermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes);
 
 	/*------------------------------------------------------------------------*//**
 	 * @brief      Makes the coordinates permutations table, this table is the
@@ -248,16 +350,29 @@ namespace segre {
 	 *             applying coordinates permutation number @c m on hyperplane
 	 *             number @c n from the @p hyperplanes.
 	 *
+	 *             The rows are computed in parallel on @p Backend.
+	 *
 	 * @param[in]  hyperplanes       The hyperplanes to generate the table
+	 * @param[in]  index             The index of @p hyperplanes
 	 *
 	 * @tparam     Dimension         Dimension of the geometry
 	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     Backend           The parallel backend
+	 * @tparam     Id                Type of the hyperplanes ids, must hold
+	 *                               @p hyperplanes size
 	 * @tparam     NbrPoints         Number of points of the geometry
 	 *
-	 * @return     The coordinates permutations table
+	 * @return     The coordinates permutations table, row major
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
-	std::vector<std::vector<unsigned int>> makeCoordPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes);
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, typename Id = std::uint32_t, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	PermutationTable<Id> makeCoordPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes, const HyperplaneIndex<NbrPoints>& index);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Makes the coordinates permutations table of @p hyperplanes, building
+	 *             their index.
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, typename Id = std::uint32_t, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	PermutationTable<Id> makeCoordPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes);
 
 	/*------------------------------------------------------------------------*//**
 	 * @brief      Makes the dimensions permutations table, this table is the
@@ -269,16 +384,50 @@ namespace segre {
 	 *             applying dimensions permutation number @c m on hyperplane
 	 *             number @c n from the @p hyperplanes.
 	 *
+	 *             The rows are computed in parallel on @p Backend.
+	 *
 	 * @param[in]  hyperplanes       The hyperplanes to generate the table
+	 * @param[in]  index             The index of @p hyperplanes
 	 *
 	 * @tparam     Dimension         Dimension of the geometry
 	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     Backend           The parallel backend
+	 * @tparam     Id                Type of the hyperplanes ids, must hold
+	 *                               @p hyperplanes size
 	 * @tparam     NbrPoints         Number of points of the geometry
 	 *
-	 * @return     The dimensions permutations table
+	 * @return     The dimensions permutations table, row major
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
-	std::vector<std::vector<unsigned int>> makeDimensionPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes);
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, typename Id = std::uint32_t, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	PermutationTable<Id> makeDimensionPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes, const HyperplaneIndex<NbrPoints>& index);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Makes the dimensions permutations table of @p hyperplanes, building
+	 *             their index.
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, typename Id = std::uint32_t, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	PermutationTable<Id> makeDimensionPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Implementation of the permutations tables makers.
+	 *
+	 * @param[in]  hyperplanes          The hyperplanes to generate the table
+	 * @param[in]  index                The index of @p hyperplanes
+	 * @param[in]  permutations         The compiled permutations, one column
+	 *                                  of the table each
+	 *
+	 * @tparam     Backend              The parallel backend
+	 * @tparam     Id                   Type of the hyperplanes ids
+	 * @tparam     NbrPoints            Number of points of the geometry
+	 *
+	 * @return     The permutations table
+	 */
+	template<ParallelBackend Backend, typename Id, size_t NbrPoints>
+	PermutationTable<Id> makePermutationsTable_impl(
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& index,
+	  const std::vector<PointPermutation<NbrPoints>>& permutations
+	);
 }
 
 // Implementations
@@ -363,17 +512,18 @@ namespace segre {
 		permuted_hyperplane.reserve(hyperplane.size());
 		for(unsigned int point : hyperplane) {
 			std::array<unsigned int, Dimension> permuted_point_coords;
+			std::array<unsigned int, Dimension> point_coords;
 			unsigned int i = 0;
 			iterateOnTuple([&](const auto& sub_permutation) {
 				if(i < Dimension) {
 					// swap coord
-					permuted_point_coords[i] = sub_permutation[point % NbrPointsPerLine];
+					point_coords[i] = sub_permutation[point % NbrPointsPerLine];
 					point /= NbrPointsPerLine;
 				}
 				else {
-					// swap dimension
+					// swap dimension, coordinate j goes to dimension sub_permutation[j]
 					for(unsigned int j = 0; j < Dimension; ++j) {
-						std::swap(permuted_point_coords[j], permuted_point_coords[sub_permutation[j]]);
+						permuted_point_coords[sub_permutation[j]] = point_coords[j];
 					}
 				}
 				++i;
@@ -423,92 +573,147 @@ namespace segre {
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
-	std::vector<std::tuple<std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>, std::array<unsigned int, Dimension>>> computeHyperplaneStabilisationPermutations(std::bitset<NbrPoints> hyperplane) {
-		std::vector<unsigned int> points = bitsetToVector(hyperplane);
-		std::vector<std::tuple<std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>, std::array<unsigned int, Dimension>>> hyperplane_stabilisation_permutations;
+	PointPermutation<NbrPoints> compilePermutation(const std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>& coord_permutations, const std::array<unsigned int, Dimension>& dimension_permutation) {
+		static_assert(NbrPoints <= 65536, "Points images are stored on 16 bits");
+
+		std::array<unsigned int, Dimension> dimension_weights;
+		for(unsigned int i = 0; i < Dimension; ++i) {
+			dimension_weights[i] = math::pow(static_cast<unsigned int>(NbrPointsPerLine), dimension_permutation[i]);
+		}
 
-		auto multi_permutations_generator = makeMultiPermutationsGenerator<Dimension, NbrPointsPerLine>();
-		while(!multi_permutations_generator.isFinished()) {
-			const auto current_permutation = multi_permutations_generator.nextPermutation();
-			if(points == applyPermutation<Dimension, NbrPointsPerLine>(points, multi_permutations_generator.nextPermutation())) {
-				hyperplane_stabilisation_permutations.push_back(convertPermutation<Dimension, NbrPointsPerLine>(current_permutation));
+		PointPermutation<NbrPoints> permutation;
+		for(unsigned int point = 0; point < NbrPoints; ++point) {
+			unsigned int remaining = point;
+			unsigned int permuted_point = 0;
+			for(unsigned int i = 0; i < Dimension; ++i) {
+				permuted_point += coord_permutations[i][remaining % NbrPointsPerLine] * dimension_weights[i];
+				remaining /= NbrPointsPerLine;
 			}
+			permutation[point] = static_cast<std::uint16_t>(permuted_point);
 		}
+		return permutation;
+	}
 
-		return hyperplane_stabilisation_permutations;
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	std::vector<PointPermutation<NbrPoints>> compileMultiPermutations() {
+		const PermutationRange<decltype(makeMultiPermutationsGenerator<Dimension, NbrPointsPerLine>())> multi_permutations;
+		std::vector<PointPermutation<NbrPoints>> permutations;
+		permutations.reserve(multi_permutations.size());
+		for(const auto& multi_permutation : multi_permutations) {
+			const auto permutation = convertPermutation<Dimension, NbrPointsPerLine>(multi_permutation);
+			permutations.push_back(compilePermutation<Dimension, NbrPointsPerLine>(std::get<0>(permutation), std::get<1>(permutation)));
+		}
+		return permutations;
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
-	std::vector<std::vector<unsigned int>> makePermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes) {
-		std::vector<std::vector<unsigned int>> permutations_table;
-		permutations_table.reserve(hyperplanes.size());
-
-		for(const std::bitset<NbrPoints>& hyperplane : hyperplanes) {
-			auto multi_permutations_generator = segre::makeMultiPermutationsGenerator<Dimension, NbrPointsPerLine>();
-			std::vector<unsigned int> hyperplane_permutations;
-			hyperplane_permutations.reserve(decltype(multi_permutations_generator)::getPermutationsNumber());
-			const std::vector<unsigned int> points = segre::bitsetToVector(hyperplane);
-
-			while(!multi_permutations_generator.isFinished()) {
-				const std::bitset<NbrPoints> hyperplane_permutation = segre::vectorToBitset<NbrPoints>(segre::applyPermutation<Dimension, NbrPointsPerLine>(points, multi_permutations_generator.nextPermutation()));
-				const ptrdiff_t pos = std::find(hyperplanes.cbegin(), hyperplanes.cend(), hyperplane_permutation) - hyperplanes.cbegin();
-				if(pos > static_cast<ptrdiff_t>(hyperplanes.size())) {
-					IMPOSSIBLE;
-				}
-				hyperplane_permutations.push_back(static_cast<unsigned int>(pos));
-			}
-			permutations_table.push_back(std::move(hyperplane_permutations));
+	std::vector<PointPermutation<NbrPoints>> compileCoordPermutations() {
+		std::array<unsigned int, Dimension> identity;
+		for(unsigned int i = 0; i < Dimension; ++i) {
+			identity[i] = i;
 		}
 
-		return permutations_table;
+		const PermutationRange<decltype(makeCoordPermutationsGenerator<Dimension, NbrPointsPerLine>())> multi_permutations;
+		std::vector<PointPermutation<NbrPoints>> permutations;
+		permutations.reserve(multi_permutations.size());
+		for(const auto& multi_permutation : multi_permutations) {
+			std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension> coord_permutations;
+			unsigned int i = 0;
+			iterateOnTuple([&](const std::array<unsigned int, NbrPointsPerLine>& sub_permutation) {
+				coord_permutations[i++] = sub_permutation;
+			}, multi_permutation);
+			permutations.push_back(compilePermutation<Dimension, NbrPointsPerLine>(coord_permutations, identity));
+		}
+		return permutations;
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
-	std::vector<std::vector<unsigned int>> makeCoordPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes) {
-		std::vector<std::vector<unsigned int>> permutations_table;
-		permutations_table.reserve(hyperplanes.size());
-
-		for(const std::bitset<NbrPoints>& hyperplane : hyperplanes) {
-			auto coord_permutations_generator = segre::makeCoordPermutationsGenerator<Dimension, NbrPointsPerLine>();
-			std::vector<unsigned int> hyperplane_permutations;
-			hyperplane_permutations.reserve(decltype(coord_permutations_generator)::getPermutationsNumber());
-			const std::vector<unsigned int> points = segre::bitsetToVector(hyperplane);
-
-			while(!coord_permutations_generator.isFinished()) {
-				const std::bitset<NbrPoints> hyperplane_permutation = segre::vectorToBitset<NbrPoints>(segre::applyCoordPermutation<Dimension, NbrPointsPerLine>(points, coord_permutations_generator.nextPermutation()));
-				const ptrdiff_t pos = std::find(hyperplanes.cbegin(), hyperplanes.cend(), hyperplane_permutation) - hyperplanes.cbegin();
-				if(pos > static_cast<ptrdiff_t>(hyperplanes.size())) {
-					IMPOSSIBLE;
-				}
-				hyperplane_permutations.push_back(static_cast<unsigned int>(pos));
+	std::vector<PointPermutation<NbrPoints>> compileDimensionPermutations() {
+		std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension> identities;
+		for(std::array<unsigned int, NbrPointsPerLine>& identity : identities) {
+			for(unsigned int i = 0; i < NbrPointsPerLine; ++i) {
+				identity[i] = i;
 			}
-			permutations_table.push_back(std::move(hyperplane_permutations));
 		}
 
-		return permutations_table;
+		const PermutationRange<PermutationGenerator<Dimension>> dimension_permutations;
+		std::vector<PointPermutation<NbrPoints>> permutations;
+		permutations.reserve(dimension_permutations.size());
+		for(const std::array<unsigned int, Dimension>& dimension_permutation : dimension_permutations) {
+			permutations.push_back(compilePermutation<Dimension, NbrPointsPerLine>(identities, dimension_permutation));
+		}
+		return permutations;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	std::vector<std::tuple<std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>, std::array<unsigned int, Dimension>>> computeHyperplaneStabilisationPermutations(std::bitset<NbrPoints> hyperplane) {
+		std::vector<std::tuple<std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>, std::array<unsigned int, Dimension>>> hyperplane_stabilisation_permutations;
+
+		detail::StabilizerSearch<Dimension, NbrPointsPerLine> search(hyperplane);
+		search.forEachElement([&hyperplane_stabilisation_permutations](const auto& permutation) {
+			hyperplane_stabilisation_permutations.push_back(permutation);
+		});
+
+		return hyperplane_stabilisation_permutations;
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
-	std::vector<std::vector<unsigned int>> makeDimensionPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes) {
-		std::vector<std::vector<unsigned int>> permutations_table;
-		permutations_table.reserve(hyperplanes.size());
-
-		for(const std::bitset<NbrPoints>& hyperplane : hyperplanes) {
-			PermutationGenerator<Dimension> coord_permutations_generator;
-			std::vector<unsigned int> hyperplane_permutations;
-			hyperplane_permutations.reserve(PermutationGenerator<Dimension>::getPermutationsNumber());
-			const std::vector<unsigned int> points = segre::bitsetToVector(hyperplane);
-
-			while(!coord_permutations_generator.isFinished()) {
-				const std::bitset<NbrPoints> hyperplane_permutation = segre::vectorToBitset<NbrPoints>(segre::applyDimensionPermutation<Dimension, NbrPointsPerLine>(points, coord_permutations_generator.nextPermutation()));
-				const ptrdiff_t pos = std::find(hyperplanes.cbegin(), hyperplanes.cend(), hyperplane_permutation) - hyperplanes.cbegin();
-				if(pos > static_cast<ptrdiff_t>(hyperplanes.size())) {
-					IMPOSSIBLE;
+	HyperplaneStabilizer<Dimension, NbrPointsPerLine> computeHyperplaneStabilizer(const std::bitset<NbrPoints>& hyperplane) {
+		return detail::StabilizerSearch<Dimension, NbrPointsPerLine>(hyperplane).computeStabilizer();
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, typename Id, size_t NbrPoints>
+	PermutationTable<Id> makePermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes, const HyperplaneIndex<NbrPoints>& index) {
+		return makePermutationsTable_impl<Backend, Id>(hyperplanes, index, compileMultiPermutations<Dimension, NbrPointsPerLine>());
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, typename Id, size_t NbrPoints>
+	PermutationTable<Id> makePermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes) {
+		return makePermutationsTable<Dimension, NbrPointsPerLine, Backend, Id>(hyperplanes, HyperplaneIndex<NbrPoints>(hyperplanes));
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, typename Id, size_t NbrPoints>
+	PermutationTable<Id> makeCoordPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes, const HyperplaneIndex<NbrPoints>& index) {
+		return makePermutationsTable_impl<Backend, Id>(hyperplanes, index, compileCoordPermutations<Dimension, NbrPointsPerLine>());
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, typename Id, size_t NbrPoints>
+	PermutationTable<Id> makeCoordPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes) {
+		return makeCoordPermutationsTable<Dimension, NbrPointsPerLine, Backend, Id>(hyperplanes, HyperplaneIndex<NbrPoints>(hyperplanes));
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, typename Id, size_t NbrPoints>
+	PermutationTable<Id> makeDimensionPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes, const HyperplaneIndex<NbrPoints>& index) {
+		return makePermutationsTable_impl<Backend, Id>(hyperplanes, index, compileDimensionPermutations<Dimension, NbrPointsPerLine>());
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, typename Id, size_t NbrPoints>
+	PermutationTable<Id> makeDimensionPermutationsTable(const std::vector<std::bitset<NbrPoints>>& hyperplanes) {
+		return makeDimensionPermutationsTable<Dimension, NbrPointsPerLine, Backend, Id>(hyperplanes, HyperplaneIndex<NbrPoints>(hyperplanes));
+	}
+
+	template<ParallelBackend Backend, typename Id, size_t NbrPoints>
+	PermutationTable<Id> makePermutationsTable_impl(
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& index,
+	  const std::vector<PointPermutation<NbrPoints>>& permutations
+	) {
+		if(!PermutationTable<Id>::canHold(hyperplanes.size())) {
+			IMPOSSIBLE;
+		}
+		PermutationTable<Id> permutations_table(hyperplanes.size(), permutations.size());
+
+		parallelChunks<Backend>(hyperplanes.size(), [&](size_t, size_t begin, size_t end) {
+			for(size_t i = begin; i < end; ++i) {
+				for(size_t j = 0; j < permutations.size(); ++j) {
+					const unsigned int pos = index.find(permuteHyperplane(hyperplanes[i], permutations[j]));
+					if(pos == HyperplaneIndex<NbrPoints>::NOT_FOUND) {
+						IMPOSSIBLE;
+					}
+					permutations_table.set(i, j, static_cast<Id>(pos));
 				}
-				hyperplane_permutations.push_back(static_cast<unsigned int>(pos));
 			}
-			permutations_table.push_back(std::move(hyperplane_permutations));
-		}
+		});
 
 		return permutations_table;
 	}
@@ -0,0 +1,307 @@
+#ifndef HYPERPLANEFINDER_LAYERTUPLE_HPP
+#define HYPERPLANEFINDER_LAYERTUPLE_HPP
+
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "BitsetWords.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compact representation of an hyperplane of a geometry of
+	 *             dimension @c Dimension + 1 built from @p NbrPointsPerLine
+	 *             layers of the geometry of dimension @c Dimension.
+	 *
+	 * @details    Each layer is either the id of an hyperplane of the previous
+	 *             dimension catalog (its index in the hyperplanes vector) or
+	 *             FULL if the layer contains all the points of the previous
+	 *             geometry.
+	 *
+	 *             Layer @c i covers the points [@c i * @c NbrPoints, (@c i + 1)
+	 *             * @c NbrPoints) of the expanded hyperplane, as in
+	 *             PointGeometry::computeHyperplanesFromVeldkampLines().
+	 *
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 */
+	template<size_t NbrPointsPerLine>
+	struct LayerTuple {
+		static constexpr std::uint32_t FULL = std::numeric_limits<std::uint32_t>::max();
+
+		bool operator==(const LayerTuple<NbrPointsPerLine>& tuple) const {
+			return layers == tuple.layers;
+		}
+
+		bool operator!=(const LayerTuple<NbrPointsPerLine>& tuple) const {
+			return layers != tuple.layers;
+		}
+
+		bool operator<(const LayerTuple<NbrPointsPerLine>& tuple) const {
+			return layers < tuple.layers;
+		}
+
+		std::array<std::uint32_t, NbrPointsPerLine> layers;
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Get the layer number @p layer of @p tuple as an hyperplane of
+	 *             the previous dimension.
+	 *
+	 * @param[in]  tuple                The layer tuple
+	 * @param[in]  layer                The layer number
+	 * @param[in]  previous_hyperplanes The previous dimension hyperplanes
+	 *                                  catalog
+	 *
+	 * @tparam     NbrPointsPerLine     Number of points per lines of the
+	 *                                  geometry
+	 * @tparam     NbrPoints            Number of points of the previous
+	 *                                  geometry
+	 *
+	 * @return     The layer points
+	 */
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	std::bitset<NbrPoints> getLayer(
+	  const LayerTuple<NbrPointsPerLine>& tuple,
+	  size_t layer,
+	  const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Expand a layer tuple to the std::bitset representation of
+	 *             the hyperplane.
+	 *
+	 * @param[in]  tuple                The layer tuple to expand
+	 * @param[in]  previous_hyperplanes The previous dimension hyperplanes
+	 *                                  catalog
+	 *
+	 * @tparam     NbrPointsPerLine     Number of points per lines of the
+	 *                                  geometry
+	 * @tparam     NbrPoints            Number of points of the previous
+	 *                                  geometry
+	 *
+	 * @return     The expanded hyperplane
+	 */
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	std::bitset<NbrPoints * NbrPointsPerLine> expandLayerTuple(
+	  const LayerTuple<NbrPointsPerLine>& tuple,
+	  const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Expand layer tuples to the std::bitset representation of the
+	 *             hyperplanes, keeping their order.
+	 *
+	 * @param[in]  tuples               The layer tuples to expand
+	 * @param[in]  previous_hyperplanes The previous dimension hyperplanes
+	 *                                  catalog
+	 *
+	 * @tparam     NbrPointsPerLine     Number of points per lines of the
+	 *                                  geometry
+	 * @tparam     NbrPoints            Number of points of the previous
+	 *                                  geometry
+	 *
+	 * @return     The expanded hyperplanes
+	 */
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	std::vector<std::bitset<NbrPoints * NbrPointsPerLine>> expandLayerTuples(
+	  const std::vector<LayerTuple<NbrPointsPerLine>>& tuples,
+	  const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Count the points of the hyperplane represented by @p tuple
+	 *             without expanding it.
+	 *
+	 * @param[in]  tuple                The layer tuple
+	 * @param[in]  previous_counts      Number of points of each hyperplane of
+	 *                                  the previous dimension catalog
+	 * @param[in]  previous_nbr_points  Number of points of the previous
+	 *                                  geometry (size of a FULL layer)
+	 *
+	 * @tparam     NbrPointsPerLine     Number of points per lines of the
+	 *                                  geometry
+	 *
+	 * @return     The number of points of the hyperplane
+	 */
+	template<size_t NbrPointsPerLine>
+	size_t countLayerTuple(
+	  const LayerTuple<NbrPointsPerLine>& tuple,
+	  const std::vector<unsigned int>& previous_counts,
+	  size_t previous_nbr_points
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Check if the hyperplane represented by @p a is included in
+	 *             the one represented by @p b.
+	 *
+	 * @details    Layers equal or FULL in @p b are decided without looking at
+	 *             the previous dimension catalog, only the others are compared
+	 *             on the previous dimension std::bitset.
+	 *
+	 * @param[in]  a                    The potentially included layer tuple
+	 * @param[in]  b                    The potentially including layer tuple
+	 * @param[in]  previous_hyperplanes The previous dimension hyperplanes
+	 *                                  catalog
+	 *
+	 * @tparam     NbrPointsPerLine     Number of points per lines of the
+	 *                                  geometry
+	 * @tparam     NbrPoints            Number of points of the previous
+	 *                                  geometry
+	 *
+	 * @return     true if @p a is included in @p b, false otherwise
+	 */
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	bool isLayerTupleIncluded(
+	  const LayerTuple<NbrPointsPerLine>& a,
+	  const LayerTuple<NbrPointsPerLine>& b,
+	  const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Count the points of the intersection of the hyperplanes
+	 *             represented by @p a and @p b without expanding them.
+	 *
+	 * @param[in]  a                    The first layer tuple
+	 * @param[in]  b                    The second layer tuple
+	 * @param[in]  previous_hyperplanes The previous dimension hyperplanes
+	 *                                  catalog
+	 *
+	 * @tparam     NbrPointsPerLine     Number of points per lines of the
+	 *                                  geometry
+	 * @tparam     NbrPoints            Number of points of the previous
+	 *                                  geometry
+	 *
+	 * @return     The number of points of the intersection
+	 */
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	size_t countLayerTuplesIntersection(
+	  const LayerTuple<NbrPointsPerLine>& a,
+	  const LayerTuple<NbrPointsPerLine>& b,
+	  const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Intersect the hyperplanes represented by @p a and @p b.
+	 *
+	 * @details    The intersection of two hyperplanes isn't an hyperplane in
+	 *             general, so the result is expanded, but each layer is
+	 *             intersected on the previous dimension std::bitset.
+	 *
+	 * @param[in]  a                    The first layer tuple
+	 * @param[in]  b                    The second layer tuple
+	 * @param[in]  previous_hyperplanes The previous dimension hyperplanes
+	 *                                  catalog
+	 *
+	 * @tparam     NbrPointsPerLine     Number of points per lines of the
+	 *                                  geometry
+	 * @tparam     NbrPoints            Number of points of the previous
+	 *                                  geometry
+	 *
+	 * @return     The intersection
+	 */
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	std::bitset<NbrPoints * NbrPointsPerLine> intersectLayerTuples(
+	  const LayerTuple<NbrPointsPerLine>& a,
+	  const LayerTuple<NbrPointsPerLine>& b,
+	  const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes
+	);
+}
+
+// Implementations
+namespace segre {
+
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	std::bitset<NbrPoints> getLayer(const LayerTuple<NbrPointsPerLine>& tuple, size_t layer, const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes) {
+		if(tuple.layers[layer] == LayerTuple<NbrPointsPerLine>::FULL) {
+			return std::bitset<NbrPoints>().flip();
+		}
+		return previous_hyperplanes[tuple.layers[layer]];
+	}
+
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	std::bitset<NbrPoints * NbrPointsPerLine> expandLayerTuple(const LayerTuple<NbrPointsPerLine>& tuple, const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes) {
+		std::array<std::bitset<NbrPoints>, NbrPointsPerLine> layers;
+		for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+			layers[i] = getLayer(tuple, i, previous_hyperplanes);
+		}
+		return concatenateLayers(layers);
+	}
+
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	std::vector<std::bitset<NbrPoints * NbrPointsPerLine>> expandLayerTuples(const std::vector<LayerTuple<NbrPointsPerLine>>& tuples, const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes) {
+		std::vector<std::bitset<NbrPoints * NbrPointsPerLine>> hyperplanes;
+		hyperplanes.reserve(tuples.size());
+		for(const LayerTuple<NbrPointsPerLine>& tuple : tuples) {
+			hyperplanes.push_back(expandLayerTuple(tuple, previous_hyperplanes));
+		}
+		return hyperplanes;
+	}
+
+	template<size_t NbrPointsPerLine>
+	size_t countLayerTuple(const LayerTuple<NbrPointsPerLine>& tuple, const std::vector<unsigned int>& previous_counts, size_t previous_nbr_points) {
+		size_t count = 0;
+		for(std::uint32_t layer : tuple.layers) {
+			count += (layer == LayerTuple<NbrPointsPerLine>::FULL) ? previous_nbr_points : previous_counts[layer];
+		}
+		return count;
+	}
+
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	bool isLayerTupleIncluded(const LayerTuple<NbrPointsPerLine>& a, const LayerTuple<NbrPointsPerLine>& b, const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes) {
+		for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+			if(a.layers[i] == b.layers[i] || b.layers[i] == LayerTuple<NbrPointsPerLine>::FULL) {
+				continue;
+			}
+			if(a.layers[i] == LayerTuple<NbrPointsPerLine>::FULL) {
+				return false;
+			}
+			const std::bitset<NbrPoints>& layer_a = previous_hyperplanes[a.layers[i]];
+			if((layer_a & previous_hyperplanes[b.layers[i]]) != layer_a) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	size_t countLayerTuplesIntersection(const LayerTuple<NbrPointsPerLine>& a, const LayerTuple<NbrPointsPerLine>& b, const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes) {
+		size_t count = 0;
+		for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+			if(a.layers[i] == LayerTuple<NbrPointsPerLine>::FULL) {
+				count += (b.layers[i] == LayerTuple<NbrPointsPerLine>::FULL) ? NbrPoints : previous_hyperplanes[b.layers[i]].count();
+			}
+			else if(b.layers[i] == LayerTuple<NbrPointsPerLine>::FULL || a.layers[i] == b.layers[i]) {
+				count += previous_hyperplanes[a.layers[i]].count();
+			}
+			else {
+				count += (previous_hyperplanes[a.layers[i]] & previous_hyperplanes[b.layers[i]]).count();
+			}
+		}
+		return count;
+	}
+
+	template<size_t NbrPointsPerLine, size_t NbrPoints>
+	std::bitset<NbrPoints * NbrPointsPerLine> intersectLayerTuples(const LayerTuple<NbrPointsPerLine>& a, const LayerTuple<NbrPointsPerLine>& b, const std::vector<std::bitset<NbrPoints>>& previous_hyperplanes) {
+		std::array<std::bitset<NbrPoints>, NbrPointsPerLine> layers;
+		for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+			if(a.layers[i] == b.layers[i] || b.layers[i] == LayerTuple<NbrPointsPerLine>::FULL) {
+				layers[i] = getLayer(a, i, previous_hyperplanes);
+			}
+			else if(a.layers[i] == LayerTuple<NbrPointsPerLine>::FULL) {
+				layers[i] = previous_hyperplanes[b.layers[i]];
+			}
+			else {
+				layers[i] = previous_hyperplanes[a.layers[i]] & previous_hyperplanes[b.layers[i]];
+			}
+		}
+		return concatenateLayers(layers);
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_LAYERTUPLE_HPP
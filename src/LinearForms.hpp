@@ -0,0 +1,513 @@
+#ifndef HYPERPLANEFINDER_LINEARFORMS_HPP
+#define HYPERPLANEFINDER_LINEARFORMS_HPP
+
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <experimental/filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "FlatHashMap.hpp"
+#include "ParallelFor.hpp"
+#include "PointGeometry.hpp"
+#include "VeldkampLineRuns.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      GF(3) linear form on the tensor space of a geometry (see
+	 *             PointGeometry::buildTensorPoints()), packed in base 3:
+	 *             coefficient @c i is the digit of weight 3^@c i.
+	 *
+	 * @details    The forms are normalized, their first non zero coefficient
+	 *             is 1: the two non zero multiples of a form have the same
+	 *             zeros, so a projective hyperplane has a single normalized
+	 *             form. The zero form never is the form of an hyperplane.
+	 */
+	using LinearForm = std::uint64_t;
+
+	constexpr LinearForm NO_LINEAR_FORM = 0;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Pack and normalize the coefficients of a linear form.
+	 *
+	 * @param[in]  coefficients  The coefficients, in {0, 1, 2}
+	 *
+	 * @tparam     TensorSize    Size of the tensors of the geometry
+	 *
+	 * @return     The normalized linear form
+	 */
+	template<size_t TensorSize>
+	LinearForm packLinearForm(const std::array<unsigned int, TensorSize>& coefficients);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Get the coefficients of a linear form.
+	 *
+	 * @tparam     TensorSize  Size of the tensors of the geometry
+	 */
+	template<size_t TensorSize>
+	std::array<unsigned int, TensorSize> unpackLinearForm(LinearForm form);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compute the linear forms vanishing on points of a geometry.
+	 *
+	 * @details    The forms are a basis of the kernel of the matrix of the
+	 *             points (see PointGeometry::buildMatrix()), reduced to a row
+	 *             echelon form one point at a time: a form per column without
+	 *             pivot.
+	 *
+	 * @param[in]  geometry  The geometry
+	 * @param[in]  points    The points
+	 *
+	 * @return     The coefficients of the forms of the basis
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	std::vector<std::array<unsigned int, TensorSize>> computeVanishingLinearForms(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::bitset<NbrPoints>& points
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compute the zeros of a linear form among the points of a
+	 *             geometry: the hyperplane of the form.
+	 *
+	 * @param[in]  points        The points of the geometry in the tensor space,
+	 *                           in order (PointGeometry::buildMatrix() of all
+	 *                           the points)
+	 * @param[in]  coefficients  The coefficients of the form
+	 *
+	 * @tparam     NbrPoints     Number of points of the geometry
+	 * @tparam     TensorSize    Size of the tensors of the geometry
+	 */
+	template<size_t NbrPoints, size_t TensorSize>
+	std::bitset<NbrPoints> computeLinearFormZeros(
+	  const std::vector<std::array<unsigned int, TensorSize>>& points,
+	  const std::array<unsigned int, TensorSize>& coefficients
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compute the linear form of a projective hyperplane: the form
+	 *             whose zeros are the points of the hyperplane.
+	 *
+	 * @details    The form spans the kernel of the matrix of the points of the
+	 *             hyperplane (see computeVanishingLinearForms()), which must
+	 *             be of dimension 1. The other points are then checked not to
+	 *             be zeros of the form.
+	 *
+	 * @param[in]  geometry    The geometry
+	 * @param[in]  hyperplane  An hyperplane of the geometry
+	 *
+	 * @return     The normalized linear form, NO_LINEAR_FORM if the hyperplane
+	 *             isn't projective
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	LinearForm computeLinearForm(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::bitset<NbrPoints>& hyperplane
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compute the linear forms of hyperplanes (see
+	 *             computeLinearForm()).
+	 *
+	 * @tparam     Backend  The parallel backend
+	 *
+	 * @return     The linear form of each hyperplane, NO_LINEAR_FORM for the
+	 *             hyperplanes which aren't projective
+	 */
+	template<ParallelBackend Backend = ParallelBackend::Sequential, size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	std::vector<LinearForm> computeLinearForms(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Hash index from a linear form to the id of its hyperplane
+	 *             (its index in the linear forms vector it has been built
+	 *             from).
+	 */
+	class LinearFormIndex {
+
+	public:
+
+		static constexpr unsigned int NOT_FOUND = std::numeric_limits<unsigned int>::max();
+
+		/*------------------------------------------------------------------------*//**
+		 * @param[in]  forms  The linear forms of the hyperplanes, NO_LINEAR_FORM
+		 *                    ones aren't indexed
+		 */
+		explicit LinearFormIndex(const std::vector<LinearForm>& forms);
+
+		unsigned int find(LinearForm form) const;
+
+		size_t size() const;
+
+	private:
+
+		struct Hash {
+			size_t operator()(LinearForm form) const {
+				return hashCombine(0, form);
+			}
+		};
+
+		FlatHashMap<LinearForm, unsigned int, Hash> m_index;
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compute the projective veldkamp lines of a geometry from the
+	 *             linear forms of its hyperplanes.
+	 *
+	 * @details    The projective line through the hyperplanes of the forms f
+	 *             and g is {f, g, f + g, f + 2g}. Each pair of forms is
+	 *             completed by two lookups in @p index, and a line is kept from
+	 *             the pair of its two smallest ids: it is a cross-check of
+	 *             PointGeometry::computeVeldkampLines() in O(n^2) instead of
+	 *             O(n^3).
+	 *
+	 * @param[in]  forms             The linear forms of the hyperplanes (see
+	 *                               computeLinearForms())
+	 * @param[in]  index             Index of @p forms
+	 *
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry,
+	 *                               4 as the forms are over GF(3)
+	 * @tparam     TensorSize        Size of the tensors of the geometry
+	 * @tparam     Backend           The parallel backend
+	 *
+	 * @return     The projective lines, as increasing ids of hyperplanes, in
+	 *             lexicographic order
+	 */
+	template<size_t NbrPointsPerLine, size_t TensorSize, ParallelBackend Backend = ParallelBackend::Sequential>
+	std::vector<std::array<unsigned int, NbrPointsPerLine>> computeProjectiveLinesFromLinearForms(
+	  const std::vector<LinearForm>& forms,
+	  const LinearFormIndex& index
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Write the projective veldkamp lines of a geometry to a run
+	 *             file, for the geometries whose lines don't fit in memory.
+	 *
+	 * @details    The lines are the ones of
+	 *             computeProjectiveLinesFromLinearForms(), in the same order,
+	 *             written as they are found with the fields of their lines
+	 *             table entry. The forms are unpacked as they are used. An
+	 *             existing file is complete (see RecordFileWriter) and kept,
+	 *             so an interrupted computation restarts after it.
+	 *
+	 * @param[in]  geometry           The geometry
+	 * @param[in]  hyperplanes        The hyperplanes of the geometry
+	 * @param[in]  hyperplanes_types  The type of each hyperplane (see
+	 *                                HyperplanesTable)
+	 * @param[in]  forms              The linear forms of the hyperplanes (see
+	 *                                computeLinearForms())
+	 * @param[in]  index              Index of @p forms
+	 * @param[in]  path               The run file
+	 *
+	 * @return     False and a message on std::cerr if the file couldn't be
+	 *             written
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	bool writeProjectiveLinesFromLinearForms(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const std::vector<unsigned int>& hyperplanes_types,
+	  const std::vector<LinearForm>& forms,
+	  const LinearFormIndex& index,
+	  const std::string& path
+	);
+}
+
+// Implementations
+namespace segre {
+
+	namespace detail {
+		template<size_t TensorSize>
+		constexpr void checkLinearFormSize() {
+			// 3^40 < 2^64
+			static_assert(TensorSize <= 40, "The coefficients of a linear form are packed in 64 bits");
+		}
+	}
+
+	template<size_t TensorSize>
+	LinearForm packLinearForm(const std::array<unsigned int, TensorSize>& coefficients) {
+		detail::checkLinearFormSize<TensorSize>();
+
+		// Multiplying by 2 the form with a first coefficient of 2 makes it 1
+		unsigned int factor = 0;
+		LinearForm form = 0;
+		LinearForm weight = 1;
+		for(size_t i = 0; i < TensorSize; ++i) {
+			if(factor == 0) {
+				factor = coefficients[i];
+			}
+			form += weight * (factor * coefficients[i] % 3);
+			weight *= 3;
+		}
+		return form;
+	}
+
+	template<size_t TensorSize>
+	std::array<unsigned int, TensorSize> unpackLinearForm(LinearForm form) {
+		detail::checkLinearFormSize<TensorSize>();
+
+		std::array<unsigned int, TensorSize> coefficients;
+		for(size_t i = 0; i < TensorSize; ++i) {
+			coefficients[i] = static_cast<unsigned int>(form % 3);
+			form /= 3;
+		}
+		return coefficients;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	std::vector<std::array<unsigned int, TensorSize>> computeVanishingLinearForms(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::bitset<NbrPoints>& points
+	) {
+		using Vector = std::array<unsigned int, TensorSize>;
+
+		// Reduced row echelon form of the points
+		std::array<Vector, TensorSize> basis;
+		std::array<size_t, TensorSize> pivots;
+		size_t rank = 0;
+		for(Vector point : geometry.buildMatrix(points)) {
+			for(size_t row = 0; row < rank; ++row) {
+				const unsigned int factor = point[pivots[row]];
+				if(factor != 0) {
+					for(size_t i = 0; i < TensorSize; ++i) {
+						point[i] = (point[i] + (3 - factor) * basis[row][i]) % 3;
+					}
+				}
+			}
+
+			size_t pivot = 0;
+			while(pivot < TensorSize && point[pivot] == 0) {
+				++pivot;
+			}
+			if(pivot == TensorSize) {
+				continue;
+			}
+			if(point[pivot] == 2) {
+				for(unsigned int& coefficient : point) {
+					coefficient = coefficient * 2 % 3;
+				}
+			}
+			for(size_t row = 0; row < rank; ++row) {
+				const unsigned int factor = basis[row][pivot];
+				if(factor != 0) {
+					for(size_t i = 0; i < TensorSize; ++i) {
+						basis[row][i] = (basis[row][i] + (3 - factor) * point[i]) % 3;
+					}
+				}
+			}
+			basis[rank] = point;
+			pivots[rank] = pivot;
+			if(++rank == TensorSize) {
+				break;
+			}
+		}
+
+		// Kernel of the basis: 1 on a column without pivot, 0 on the others
+		std::array<bool, TensorSize> is_pivot{};
+		for(size_t row = 0; row < rank; ++row) {
+			is_pivot[pivots[row]] = true;
+		}
+		std::vector<Vector> forms;
+		forms.reserve(TensorSize - rank);
+		for(size_t free_column = 0; free_column < TensorSize; ++free_column) {
+			if(is_pivot[free_column]) {
+				continue;
+			}
+			Vector coefficients{};
+			coefficients[free_column] = 1;
+			for(size_t row = 0; row < rank; ++row) {
+				coefficients[pivots[row]] = (3 - basis[row][free_column]) % 3;
+			}
+			forms.push_back(coefficients);
+		}
+		return forms;
+	}
+
+	template<size_t NbrPoints, size_t TensorSize>
+	std::bitset<NbrPoints> computeLinearFormZeros(
+	  const std::vector<std::array<unsigned int, TensorSize>>& points,
+	  const std::array<unsigned int, TensorSize>& coefficients
+	) {
+		std::bitset<NbrPoints> zeros;
+		for(size_t point = 0; point < NbrPoints; ++point) {
+			unsigned int value = 0;
+			for(size_t i = 0; i < TensorSize; ++i) {
+				value += coefficients[i] * points[point][i];
+			}
+			zeros[point] = value % 3 == 0;
+		}
+		return zeros;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	LinearForm computeLinearForm(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::bitset<NbrPoints>& hyperplane
+	) {
+		using Vector = std::array<unsigned int, TensorSize>;
+
+		const std::vector<Vector> forms = computeVanishingLinearForms(geometry, hyperplane);
+		if(forms.size() != 1) {
+			return NO_LINEAR_FORM;
+		}
+
+		// The points of the hyperplane are zeros of the form, the other points must not be
+		for(const Vector& point : geometry.buildMatrix(~hyperplane)) {
+			unsigned int value = 0;
+			for(size_t i = 0; i < TensorSize; ++i) {
+				value += forms[0][i] * point[i];
+			}
+			if(value % 3 == 0) {
+				return NO_LINEAR_FORM;
+			}
+		}
+		return packLinearForm(forms[0]);
+	}
+
+	template<ParallelBackend Backend, size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	std::vector<LinearForm> computeLinearForms(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes
+	) {
+		std::vector<LinearForm> forms(hyperplanes.size());
+		parallelChunks<Backend>(hyperplanes.size(), [&](size_t, size_t begin, size_t end) {
+			for(size_t i = begin; i < end; ++i) {
+				forms[i] = computeLinearForm(geometry, hyperplanes[i]);
+			}
+		});
+		return forms;
+	}
+
+	inline LinearFormIndex::LinearFormIndex(const std::vector<LinearForm>& forms)
+	  : m_index(forms.size()) {
+
+		for(unsigned int i = 0; i < forms.size(); ++i) {
+			if(forms[i] != NO_LINEAR_FORM) {
+				m_index.insert(forms[i], i);
+			}
+		}
+	}
+
+	inline unsigned int LinearFormIndex::find(LinearForm form) const {
+		const unsigned int* id = m_index.find(form);
+		return id == nullptr ? NOT_FOUND : *id;
+	}
+
+	inline size_t LinearFormIndex::size() const {
+		return m_index.size();
+	}
+
+	template<size_t NbrPointsPerLine, size_t TensorSize, ParallelBackend Backend>
+	std::vector<std::array<unsigned int, NbrPointsPerLine>> computeProjectiveLinesFromLinearForms(
+	  const std::vector<LinearForm>& forms,
+	  const LinearFormIndex& index
+	) {
+		static_assert(NbrPointsPerLine == 4, "The lines of the projective space over GF(3) have 4 points");
+
+		std::vector<std::array<unsigned int, TensorSize>> coefficients(forms.size());
+		for(size_t i = 0; i < forms.size(); ++i) {
+			coefficients[i] = unpackLinearForm<TensorSize>(forms[i]);
+		}
+
+		// Normalized f + factor * g
+		const auto combine = [&coefficients](size_t f, size_t g, unsigned int factor) {
+			std::array<unsigned int, TensorSize> sum;
+			for(size_t i = 0; i < TensorSize; ++i) {
+				sum[i] = (coefficients[f][i] + factor * coefficients[g][i]) % 3;
+			}
+			return packLinearForm(sum);
+		};
+
+		// Lines of each chunk of first ids, concatenated in order
+		std::vector<std::vector<std::array<unsigned int, NbrPointsPerLine>>> partial_lines(getWorkersNumber<Backend>());
+		parallelChunks<Backend>(forms.size(), [&](size_t chunk, size_t begin, size_t end) {
+			for(unsigned int f = static_cast<unsigned int>(begin); f < end; ++f) {
+				if(forms[f] == NO_LINEAR_FORM) {
+					continue;
+				}
+				for(unsigned int g = f + 1; g < forms.size(); ++g) {
+					if(forms[g] == NO_LINEAR_FORM) {
+						continue;
+					}
+					const unsigned int h1 = index.find(combine(f, g, 1));
+					const unsigned int h2 = index.find(combine(f, g, 2));
+					if(h1 > g && h2 > g && h1 != LinearFormIndex::NOT_FOUND && h2 != LinearFormIndex::NOT_FOUND) {
+						partial_lines[chunk].push_back({{f, g, std::min(h1, h2), std::max(h1, h2)}});
+					}
+				}
+			}
+		});
+
+		std::vector<std::array<unsigned int, NbrPointsPerLine>> lines;
+		for(const std::vector<std::array<unsigned int, NbrPointsPerLine>>& partial : partial_lines) {
+			lines.insert(lines.end(), partial.cbegin(), partial.cend());
+		}
+		return lines;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	bool writeProjectiveLinesFromLinearForms(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const std::vector<unsigned int>& hyperplanes_types,
+	  const std::vector<LinearForm>& forms,
+	  const LinearFormIndex& index,
+	  const std::string& path
+	) {
+		static_assert(NbrPointsPerLine == 4, "The lines of the projective space over GF(3) have 4 points");
+
+		if(std::experimental::filesystem::exists(path)) {
+			return true;
+		}
+
+		VeldkampLineRunWriter<NbrPointsPerLine> projectives(path);
+		for(unsigned int f = 0; f < forms.size(); ++f) {
+			if(forms[f] == NO_LINEAR_FORM) {
+				continue;
+			}
+			const std::array<unsigned int, TensorSize> coefficients_f = unpackLinearForm<TensorSize>(forms[f]);
+			for(unsigned int g = f + 1; g < forms.size(); ++g) {
+				if(forms[g] == NO_LINEAR_FORM) {
+					continue;
+				}
+				const std::array<unsigned int, TensorSize> coefficients_g = unpackLinearForm<TensorSize>(forms[g]);
+
+				// Normalized f + g and f + 2g
+				std::array<unsigned int, TensorSize> sum1;
+				std::array<unsigned int, TensorSize> sum2;
+				for(size_t i = 0; i < TensorSize; ++i) {
+					sum1[i] = (coefficients_f[i] + coefficients_g[i]) % 3;
+					sum2[i] = (coefficients_f[i] + 2 * coefficients_g[i]) % 3;
+				}
+				const unsigned int h1 = index.find(packLinearForm(sum1));
+				const unsigned int h2 = index.find(packLinearForm(sum2));
+				if(h1 <= g || h2 <= g || h1 == LinearFormIndex::NOT_FOUND || h2 == LinearFormIndex::NOT_FOUND) {
+					continue;
+				}
+
+				const std::array<unsigned int, NbrPointsPerLine> line = {{f, g, std::min(h1, h2), std::max(h1, h2)}};
+				const FlatVeldkampLineTableEntry<NbrPointsPerLine> entry = geometry.makeLinesTableEntry(true, line, hyperplanes, hyperplanes_types);
+				VeldkampLineRecord<NbrPointsPerLine> record;
+				record.line = line;
+				record.pointsType = entry.pointsType;
+				record.isProjective = 1;
+				record.coreNbrPoints = entry.coreNbrPoints;
+				record.coreNbrLines = entry.coreNbrLines;
+				projectives.add(record);
+			}
+		}
+		return projectives.close();
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_LINEARFORMS_HPP
@@ -0,0 +1,440 @@
+#ifndef HYPERPLANEFINDER_OUTOFCOREHYPERPLANES_HPP
+#define HYPERPLANEFINDER_OUTOFCOREHYPERPLANES_HPP
+
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <experimental/filesystem>
+
+#include "BitsetWords.hpp"
+#include "EntriesCounter.hpp"
+#include "FlatHashMap.hpp"
+#include "HyperplaneCatalog.hpp"
+#include "HyperplaneIndex.hpp"
+#include "HyperplaneTableEntry.hpp"
+#include "LayerTuple.hpp"
+#include "ParallelFor.hpp"
+#include "PointGeometry.hpp"
+#include "RadixSort.hpp"
+#include "RecordFile.hpp"
+#include "VeldkampLineRuns.hpp"
+#include "math.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Layer tuple with its position in the generation order, record
+	 *             of the deduplication partitions.
+	 */
+	template<size_t NbrPointsPerLine>
+	struct SequencedLayerTuple {
+		LayerTuple<NbrPointsPerLine> tuple;
+		std::uint64_t sequence;
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compute the hyperplanes of a geometry from the projective
+	 *             veldkamp lines of the previous one, and their table, without
+	 *             holding them in memory.
+	 *
+	 * @details    The layer tuples are generated in the order of
+	 *             PointGeometry::computeLayerTuplesFromVeldkampLines() and
+	 *             spread by hash over partition files sized to the memory
+	 *             budget, generated again for each group of
+	 *             MAX_OUT_OF_CORE_OPEN_FILES partitions. The partitions are
+	 *             deduplicated in parallel, the first occurrence of a tuple
+	 *             being kept, and merged back in the generation order by k-way
+	 *             merges of at most MAX_OUT_OF_CORE_OPEN_FILES runs. The tuples
+	 *             catalog is then streamed by chunks to build the table, each
+	 *             chunk in parallel.
+	 *
+	 *             The directory receives the records files "hyperplanes" (the
+	 *             layer tuples of the hyperplanes) and "types" (the entry number
+	 *             of each hyperplane in the table, as HyperplanesTable::types).
+	 *             The table and the hyperplanes order are the ones of
+	 *             makeHyperplaneTable() on computeHyperplanesFromVeldkampLines().
+	 *
+	 * @param[in]  nextGeometry      The geometry of the hyperplanes
+	 * @param[in]  catalog           The hyperplanes of the previous geometry
+	 * @param[in]  projectives_path  The records file of the projective lines of
+	 *                               the previous geometry (see
+	 *                               writeProjectiveLinesFromLinearForms())
+	 * @param[in]  index             Index of the hyperplanes of the previous
+	 *                               geometry
+	 * @param[in]  types             Entry number of the hyperplanes of the
+	 *                               previous geometry in their table
+	 * @param[in]  options           Directory of the files and memory budget
+	 * @param[out] nbr_hyperplanes   The number of hyperplanes
+	 * @param[out] table             The hyperplanes table, its types are left
+	 *                               empty (see the "types" file)
+	 *
+	 * @tparam     OrderOfPoints     Compute the points orders of the entries
+	 * @tparam     Backend           The parallel backend
+	 *
+	 * @return     False and a message on std::cerr if a file couldn't be read or
+	 *             written
+	 */
+	template<bool OrderOfPoints, ParallelBackend Backend = ParallelBackend::Sequential, size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints>
+	bool computeHyperplanesTableOutOfCore(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines>& nextGeometry,
+	  const HyperplaneCatalog<NbrPoints>& catalog,
+	  const std::string& projectives_path,
+	  const HyperplaneIndex<NbrPoints>& index,
+	  const std::vector<unsigned int>& types,
+	  const OutOfCoreOptions& options,
+	  size_t& nbr_hyperplanes,
+	  HyperplanesTable& table
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Sort the entries of an hyperplanes table computed by
+	 *             computeHyperplanesTableOutOfCore(), as
+	 *             sortHyperplanesTable(), and update its "types" file.
+	 *
+	 * @param      table      The hyperplanes table
+	 * @param[in]  directory  The directory of the computation
+	 * @param[in]  compare    The comparison function of the entries
+	 *
+	 * @tparam     Compare    Type of @p compare
+	 *
+	 * @return     False and a message on std::cerr if the file couldn't be read
+	 *             or written
+	 */
+	template<typename Compare>
+	bool sortHyperplanesTableOutOfCore(HyperplanesTable& table, const std::string& directory, Compare compare);
+
+	constexpr size_t MAX_OUT_OF_CORE_OPEN_FILES = 256; // Partitions written or runs merged at once
+}
+
+// Implementations
+namespace segre {
+
+	template<bool OrderOfPoints, ParallelBackend Backend, size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints>
+	bool computeHyperplanesTableOutOfCore(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines>& nextGeometry,
+	  const HyperplaneCatalog<NbrPoints>& catalog,
+	  const std::string& projectives_path,
+	  const HyperplaneIndex<NbrPoints>& index,
+	  const std::vector<unsigned int>& types,
+	  const OutOfCoreOptions& options,
+	  size_t& nbr_hyperplanes,
+	  HyperplanesTable& table
+	) {
+		namespace fs = std::experimental::filesystem;
+
+		static_assert(NbrPoints * NbrPointsPerLine == math::pow(NbrPointsPerLine, Dimension), "The catalog holds the hyperplanes of the previous geometry");
+
+		using Tuple = LayerTuple<NbrPointsPerLine>;
+		using Record = SequencedLayerTuple<NbrPointsPerLine>;
+		using Entry = FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>;
+
+		std::error_code error;
+		fs::create_directories(options.directory, error);
+		if(error) {
+			std::cerr << "Failed to create directory " << options.directory << std::endl;
+			return false;
+		}
+
+		RecordFileReader<VeldkampLineRecord<NbrPointsPerLine>> projectives;
+		if(!projectives.open(projectives_path)) {
+			return false;
+		}
+
+		// Partitions of the deduplication, one is loaded at once by each worker with the radix sort buffer
+		const size_t worker_budget = std::max<size_t>(options.memory_budget / getWorkersNumber<Backend>(), 1);
+		const size_t nbr_tuples = projectives.size() * math::facorial<NbrPointsPerLine> + catalog.size() * NbrPointsPerLine;
+		const size_t nbr_partitions = std::max<size_t>((nbr_tuples * 2 * sizeof(Record) + worker_budget - 1) / worker_budget, 1);
+		const auto partitionPath = [&options](size_t partition, const char* stage) {
+			return options.directory + "/" + stage + "_" + std::to_string(partition);
+		};
+
+		// Generation, the tuples are generated again for each group of partitions written
+		for(size_t pass_first = 0; pass_first < nbr_partitions; pass_first += MAX_OUT_OF_CORE_OPEN_FILES) {
+			const size_t pass_end = std::min(pass_first + MAX_OUT_OF_CORE_OPEN_FILES, nbr_partitions);
+			std::vector<RecordFileWriter<Record>> partitions;
+			partitions.reserve(pass_end - pass_first);
+			for(size_t partition = pass_first; partition < pass_end; ++partition) {
+				partitions.emplace_back(partitionPath(partition, "tuples"));
+			}
+			std::uint64_t sequence = 0;
+			const auto add = [&](const Tuple& tuple) {
+				std::uint64_t hash = 0;
+				for(std::uint32_t layer : tuple.layers) {
+					hash = hashCombine(hash, layer);
+				}
+				const size_t partition = hash % nbr_partitions;
+				if(partition >= pass_first && partition < pass_end) {
+					partitions[partition - pass_first].add({tuple, sequence});
+				}
+				++sequence;
+			};
+
+			RecordFileReader<VeldkampLineRecord<NbrPointsPerLine>> lines;
+			if(!lines.open(projectives_path)) {
+				return false;
+			}
+			VeldkampLineRecord<NbrPointsPerLine> line;
+			std::array<std::bitset<NbrPoints>, NbrPointsPerLine> hyperplanes;
+			while(lines.next(line)) {
+				for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+					hyperplanes[i] = catalog.get(line.line[i]);
+				}
+				// Same order as computeLayerTuplesFromVeldkampLines()
+				std::array<size_t, NbrPointsPerLine> order;
+				for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+					order[i] = i;
+				}
+				const auto hyperplaneLess = [&hyperplanes](size_t a, size_t b) {
+					return bitsetLess(hyperplanes[a], hyperplanes[b]);
+				};
+				std::sort(order.begin(), order.end(), hyperplaneLess);
+				do {
+					Tuple tuple;
+					for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+						tuple.layers[i] = line.line[order[i]];
+					}
+					add(tuple);
+				} while(std::next_permutation(order.begin(), order.end(), hyperplaneLess));
+			}
+			if(lines.failed()) {
+				return false;
+			}
+
+			for(std::uint32_t i = 0; i < catalog.size(); ++i) {
+				for(size_t full_layer = NbrPointsPerLine; full_layer-- > 0;) {
+					Tuple tuple;
+					tuple.layers.fill(i);
+					tuple.layers[full_layer] = Tuple::FULL;
+					add(tuple);
+				}
+			}
+
+			for(RecordFileWriter<Record>& partition : partitions) {
+				if(!partition.close()) {
+					return false;
+				}
+			}
+		}
+
+		// Deduplication, the partitions are sorted back by sequence
+		std::atomic<bool> failed(false);
+		parallelTasks<Backend>(nbr_partitions, [&](size_t partition) {
+			std::vector<Record> records;
+			const std::string path = partitionPath(partition, "tuples");
+			if(!readRecordFile<Record>(path, [&records](const Record& record) {
+				records.push_back(record);
+			})) {
+				failed = true;
+				return;
+			}
+			std::remove(path.c_str());
+
+			// The records are read in increasing sequence and the sort is stable: the first occurrence of a tuple is
+			// the first of its group
+			radixSort(records, [](const Record& record) {
+				std::array<std::uint64_t, (NbrPointsPerLine + 1) / 2> key{};
+				for(size_t i = 0; i < NbrPointsPerLine; ++i) {
+					key[i / 2] |= std::uint64_t{record.tuple.layers[i]} << (32 * (i % 2));
+				}
+				return key;
+			});
+			records.erase(std::unique(records.begin(), records.end(), [](const Record& a, const Record& b) {
+				return a.tuple == b.tuple;
+			}), records.end());
+			radixSort(records, [](const Record& record) {
+				return std::array<std::uint64_t, 1>{{record.sequence}};
+			});
+
+			RecordFileWriter<Record> unique(partitionPath(partition, "unique"));
+			for(const Record& record : records) {
+				unique.add(record);
+			}
+			if(!unique.close()) {
+				failed = true;
+			}
+		});
+		if(failed) {
+			return false;
+		}
+
+		// Merge of runs [first, last) in the generation order, the runs are removed
+		const auto mergeRuns = [](const std::vector<std::string>& runs, size_t first, size_t last, const auto& output) {
+			std::vector<RecordFileReader<Record>> readers(last - first);
+			std::vector<Record> heads(last - first);
+
+			// Binary heap of the runs by head sequence, the smallest first
+			std::vector<size_t> heap;
+			heap.reserve(readers.size());
+			const auto siftDown = [&heads, &heap](size_t position) {
+				while(true) {
+					size_t smallest = position;
+					for(size_t child = 2 * position + 1; child < heap.size() && child <= 2 * position + 2; ++child) {
+						if(heads[heap[child]].sequence < heads[heap[smallest]].sequence) {
+							smallest = child;
+						}
+					}
+					if(smallest == position) {
+						return;
+					}
+					std::swap(heap[position], heap[smallest]);
+					position = smallest;
+				}
+			};
+
+			for(size_t run = 0; run < readers.size(); ++run) {
+				if(!readers[run].open(runs[first + run])) {
+					return false;
+				}
+				if(readers[run].next(heads[run])) {
+					heap.push_back(run);
+				}
+			}
+			for(size_t position = heap.size() / 2; position-- > 0;) {
+				siftDown(position);
+			}
+			while(!heap.empty()) {
+				const size_t run = heap.front();
+				output(heads[run]);
+				if(!readers[run].next(heads[run])) {
+					heap.front() = heap.back();
+					heap.pop_back();
+				}
+				if(!heap.empty()) {
+					siftDown(0);
+				}
+			}
+			for(size_t run = 0; run < readers.size(); ++run) {
+				if(readers[run].failed()) {
+					return false;
+				}
+				std::remove(runs[first + run].c_str());
+			}
+			return true;
+		};
+
+		// The sequences are unique: runs are merged in any grouping, by passes until they can be open at once
+		{
+			std::vector<std::string> runs;
+			for(size_t partition = 0; partition < nbr_partitions; ++partition) {
+				runs.push_back(partitionPath(partition, "unique"));
+			}
+			for(size_t pass = 0; runs.size() > MAX_OUT_OF_CORE_OPEN_FILES; ++pass) {
+				std::vector<std::string> merged_runs;
+				for(size_t first = 0; first < runs.size(); first += MAX_OUT_OF_CORE_OPEN_FILES) {
+					merged_runs.push_back(options.directory + "/merged_" + std::to_string(pass) + "_" + std::to_string(merged_runs.size()));
+					RecordFileWriter<Record> merged(merged_runs.back());
+					const bool merge_succeeded = mergeRuns(runs, first, std::min(first + MAX_OUT_OF_CORE_OPEN_FILES, runs.size()), [&merged](const Record& record) {
+						merged.add(record);
+					});
+					if(!merge_succeeded || !merged.close()) {
+						return false;
+					}
+				}
+				runs = std::move(merged_runs);
+			}
+
+			RecordFileWriter<Tuple> hyperplanes(options.directory + "/hyperplanes");
+			if(!mergeRuns(runs, 0, runs.size(), [&hyperplanes](const Record& record) {
+				hyperplanes.add(record.tuple);
+			})) {
+				return false;
+			}
+			nbr_hyperplanes = hyperplanes.size();
+			if(!hyperplanes.close()) {
+				return false;
+			}
+		}
+
+		// Table, by chunks of hyperplanes
+		RecordFileReader<Tuple> hyperplanes;
+		if(!hyperplanes.open(options.directory + "/hyperplanes")) {
+			return false;
+		}
+		RecordFileWriter<std::uint32_t> hyperplanes_types(options.directory + "/types");
+		const size_t chunk_size = std::max<size_t>(options.memory_budget / (sizeof(Tuple) + sizeof(unsigned int)), 1);
+		EntriesCounter<Entry> entries;
+		std::vector<Tuple> chunk;
+		std::vector<unsigned int> chunk_types;
+		std::vector<EntriesCounter<Entry>> partial_tables;
+		Tuple tuple;
+		bool finished = false;
+		while(!finished) {
+			chunk.clear();
+			while(chunk.size() < chunk_size && hyperplanes.next(tuple)) {
+				chunk.push_back(tuple);
+			}
+			finished = chunk.size() < chunk_size;
+
+			partial_tables.assign(getWorkersNumber<Backend>(), EntriesCounter<Entry>());
+			chunk_types.resize(chunk.size());
+			parallelChunks<Backend>(chunk.size(), [&](size_t worker, size_t begin, size_t end) {
+				for(size_t i = begin; i < end; ++i) {
+					std::array<std::bitset<NbrPoints>, NbrPointsPerLine> layers;
+					for(size_t layer = 0; layer < NbrPointsPerLine; ++layer) {
+						layers[layer] = chunk[i].layers[layer] == Tuple::FULL
+						                ? std::bitset<NbrPoints>().flip()
+						                : catalog.get(chunk[i].layers[layer]);
+					}
+					const std::bitset<NbrPoints * NbrPointsPerLine> hyperplane = concatenateLayers(layers);
+					chunk_types[i] = static_cast<unsigned int>(partial_tables[worker].add(nextGeometry.template getHyperplaneTableEntry<OrderOfPoints>(hyperplane, index, types)));
+				}
+			});
+
+			// Same chunks as the partial tables, as in PointGeometry::mergeHyperplaneTables()
+			std::vector<std::vector<unsigned int>> positions(partial_tables.size());
+			for(size_t worker = 0; worker < partial_tables.size(); ++worker) {
+				for(size_t i = 0; i < partial_tables[worker].getEntries().size(); ++i) {
+					positions[worker].push_back(static_cast<unsigned int>(entries.add(partial_tables[worker].getEntries()[i], partial_tables[worker].getCounts()[i])));
+				}
+			}
+			parallelChunks<Backend>(chunk.size(), [&](size_t worker, size_t begin, size_t end) {
+				for(size_t i = begin; i < end; ++i) {
+					chunk_types[i] = positions[worker][chunk_types[i]];
+				}
+			});
+			for(unsigned int type : chunk_types) {
+				hyperplanes_types.add(type);
+			}
+		}
+		if(hyperplanes.failed() || !hyperplanes_types.close()) {
+			return false;
+		}
+
+		table = HyperplanesTable();
+		table.entries.reserve(entries.getEntries().size());
+		for(size_t i = 0; i < entries.getEntries().size(); ++i) {
+			table.entries.push_back(entries.getEntries()[i].toTableEntry(entries.getCounts()[i]));
+		}
+		return true;
+	}
+
+	template<typename Compare>
+	bool sortHyperplanesTableOutOfCore(HyperplanesTable& table, const std::string& directory, Compare compare) {
+		const std::vector<unsigned int> new_types = sortHyperplanesTableEntries(table, compare);
+
+		// The file is written under a temporary name, read until then
+		const std::string path = directory + "/types";
+		RecordFileWriter<std::uint32_t> types(path);
+		if(!readRecordFile<std::uint32_t>(path, [&types, &new_types](std::uint32_t type) {
+			types.add(new_types[type]);
+		})) {
+			return false;
+		}
+		return types.close();
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_OUTOFCOREHYPERPLANES_HPP
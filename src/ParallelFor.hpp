@@ -0,0 +1,182 @@
+#ifndef HYPERPLANEFINDER_PARALLELFOR_HPP
+#define HYPERPLANEFINDER_PARALLELFOR_HPP
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Backends able to run the parallel computations.
+	 *
+	 * @details    OpenMP is only available if the program is compiled with
+	 *             OpenMP support (CMake option HYPERPLANEFINDER_OPENMP),
+	 *             otherwise it falls back to Threads.
+	 */
+	enum class ParallelBackend {
+		Sequential, ///< Everything on the calling thread
+		Threads,    ///< One std::thread per hardware thread
+		OpenMP      ///< OpenMP parallel region
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Get the number of workers a backend runs.
+	 *
+	 * @tparam     Backend  The parallel backend
+	 *
+	 * @return     The number of workers, at least 1
+	 */
+	template<ParallelBackend Backend>
+	size_t getWorkersNumber();
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Split [0, @p size) in getWorkersNumber() contiguous chunks and
+	 *             process them in parallel.
+	 *
+	 * @details    Chunk @c i is the @c i th part of the range: merging the
+	 *             results of the chunks in order gives the result of a
+	 *             sequential run. A chunk may be empty.
+	 *
+	 * @param[in]  size      The size of the range
+	 * @param[in]  function  Function called as function(chunk, begin, end)
+	 *
+	 * @tparam     Backend   The parallel backend
+	 * @tparam     Function  Type of the function
+	 */
+	template<ParallelBackend Backend, typename Function>
+	void parallelChunks(size_t size, const Function& function);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Run @p nbr_tasks independent tasks on getWorkersNumber()
+	 *             workers.
+	 *
+	 * @details    Unlike parallelChunks(), the tasks are not assigned in
+	 *             advance: each worker takes the next task in increasing order
+	 *             as soon as it is free, so tasks of uneven durations are
+	 *             balanced. Putting the longest tasks first gives the best
+	 *             balance.
+	 *
+	 * @param[in]  nbr_tasks  The number of tasks
+	 * @param[in]  function   Function called as function(task)
+	 *
+	 * @tparam     Backend    The parallel backend
+	 * @tparam     Function   Type of the function
+	 */
+	template<ParallelBackend Backend, typename Function>
+	void parallelTasks(size_t nbr_tasks, const Function& function);
+}
+
+// Implementations
+namespace segre {
+
+	template<ParallelBackend Backend>
+	size_t getWorkersNumber() {
+		if constexpr (Backend == ParallelBackend::Sequential) {
+			return 1;
+		}
+#ifdef _OPENMP
+		else if constexpr (Backend == ParallelBackend::OpenMP) {
+			return static_cast<size_t>(std::max(omp_get_max_threads(), 1));
+		}
+#endif
+		else {
+			return std::max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t{1});
+		}
+	}
+
+	template<ParallelBackend Backend, typename Function>
+	void parallelChunks(size_t size, const Function& function) {
+		const size_t nbr_chunks = getWorkersNumber<Backend>();
+		const size_t chunk_size = size / nbr_chunks;
+		const size_t remainder = size % nbr_chunks;
+
+		// The remainder is spread over the first chunks
+		const auto chunkBegin = [=](size_t chunk) {
+			return chunk * chunk_size + std::min(chunk, remainder);
+		};
+
+		if constexpr (Backend == ParallelBackend::Sequential) {
+			function(size_t{0}, size_t{0}, size);
+		}
+#ifdef _OPENMP
+		else if constexpr (Backend == ParallelBackend::OpenMP) {
+			const long long int omp_nbr_chunks = static_cast<long long int>(nbr_chunks);
+			#pragma omp parallel for schedule(static, 1) num_threads(static_cast<int>(nbr_chunks))
+			for (long long int i = 0; i < omp_nbr_chunks; ++i) {
+				const size_t chunk = static_cast<size_t>(i);
+				function(chunk, chunkBegin(chunk), chunkBegin(chunk + 1));
+			}
+		}
+#endif
+		else {
+			// An exception escaping a worker terminates the program anyway (in the std::thread, or when the joinable
+			// threads are destroyed if it comes from the calling thread), the workers are noexcept
+			std::vector<std::thread> threads;
+			threads.reserve(nbr_chunks - 1);
+			for (size_t chunk = 1; chunk < nbr_chunks; ++chunk) {
+				threads.emplace_back([&function, &chunkBegin, chunk]() noexcept {
+					function(chunk, chunkBegin(chunk), chunkBegin(chunk + 1));
+				});
+			}
+
+			function(size_t{0}, chunkBegin(0), chunkBegin(1));
+
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+		}
+	}
+
+	template<ParallelBackend Backend, typename Function>
+	void parallelTasks(size_t nbr_tasks, const Function& function) {
+		const size_t nbr_workers = std::min(getWorkersNumber<Backend>(), nbr_tasks);
+
+		if constexpr (Backend == ParallelBackend::Sequential) {
+			for (size_t task = 0; task < nbr_tasks; ++task) {
+				function(task);
+			}
+		}
+#ifdef _OPENMP
+		else if constexpr (Backend == ParallelBackend::OpenMP) {
+			const long long int omp_nbr_tasks = static_cast<long long int>(nbr_tasks);
+			#pragma omp parallel for schedule(dynamic, 1) num_threads(static_cast<int>(std::max(nbr_workers, size_t{1})))
+			for (long long int i = 0; i < omp_nbr_tasks; ++i) {
+				function(static_cast<size_t>(i));
+			}
+		}
+#endif
+		else {
+			std::atomic<size_t> next_task(0);
+			// Same as parallelChunks(), the workers are noexcept
+			const auto work = [&function, &next_task, nbr_tasks]() noexcept {
+				for (size_t task = next_task++; task < nbr_tasks; task = next_task++) {
+					function(task);
+				}
+			};
+
+			std::vector<std::thread> threads;
+			threads.reserve(nbr_workers > 0 ? nbr_workers - 1 : 0);
+			for (size_t worker = 1; worker < nbr_workers; ++worker) {
+				threads.emplace_back(work);
+			}
+
+			work();
+
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+		}
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_PARALLELFOR_HPP
@@ -3,6 +3,12 @@
 
 
 #include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "math.hpp"
 
 namespace segre::detail {
 
@@ -145,6 +151,57 @@ namespace segre {
 			return math::facorial<nbrElements>;
 		}
 
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Permutation returned by the (@p rank + 1)-th call to
+		 *             nextPermutation().
+		 *
+		 * @details    The generator inserts element 0 at every position of each
+		 *             permutation of the elements 1..n-1, then element 1 in the
+		 *             ones of 2..n-1, and so on: the rank is a mixed radix number
+		 *             whose digit k, in base n-k, is the position of element k
+		 *             among the elements k..n-1 (a Lehmer code read by insertion).
+		 *
+		 * @param[in]  rank  The rank, lower than getPermutationsNumber()
+		 *
+		 * @return     The permutation
+		 */
+		static constexpr std::array<unsigned int, nbrElements> unrank(size_t rank) {
+			std::array<size_t, nbrElements> positions{};
+			for(size_t k = 0; k < nbrElements; ++k) {
+				positions[k] = rank % (nbrElements - k);
+				rank /= nbrElements - k;
+			}
+
+			std::array<unsigned int, nbrElements> permutation{};
+			for(size_t k = nbrElements; k-- > 0;) {
+				// Elements k+1..n-1 are in permutation[0..n-k-2], insert k at its position
+				for(size_t i = nbrElements - 1 - k; i > positions[k]; --i) {
+					permutation[i] = permutation[i - 1];
+				}
+				permutation[positions[k]] = static_cast<unsigned int>(k);
+			}
+			return permutation;
+		}
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Inverse of unrank().
+		 */
+		static constexpr size_t rank(const std::array<unsigned int, nbrElements>& permutation) {
+			size_t rank = 0;
+			size_t weight = 1;
+			for(size_t k = 0; k < nbrElements; ++k) {
+				size_t position = 0;
+				for(size_t i = 0; permutation[i] != k; ++i) {
+					if(permutation[i] > k) {
+						++position;
+					}
+				}
+				rank += position * weight;
+				weight *= nbrElements - k;
+			}
+			return rank;
+		}
+
 	private:
 
 		detail::Permutation<nbrElements> m_current_permutation;
@@ -200,8 +257,51 @@ namespace segre {
 			return (PermutationGenerator<nbrElements>::getPermutationsNumber() * ...);
 		}
 
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Permutations returned by the (@p rank + 1)-th call to
+		 *             nextPermutation().
+		 *
+		 * @details    The first permutation varies fastest: the rank is a mixed
+		 *             radix number whose digit i, in base nbrElements_i!, is the
+		 *             rank of permutation i (see PermutationGenerator::unrank()).
+		 *
+		 * @param[in]  rank  The rank, lower than getPermutationsNumber()
+		 *
+		 * @return     The permutations
+		 */
+		static constexpr std::tuple<std::array<unsigned int, nbrElements>...> unrank(size_t rank) {
+			return unrank_impl(rank, std::make_index_sequence<sizeof...(nbrElements)>());
+		}
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Inverse of unrank().
+		 */
+		static constexpr size_t rank(const std::tuple<std::array<unsigned int, nbrElements>...>& permutations) {
+			return rank_impl(permutations, std::make_index_sequence<sizeof...(nbrElements)>());
+		}
+
 	private:
 
+		static constexpr std::array<size_t, sizeof...(nbrElements)> SIZES{PermutationGenerator<nbrElements>::getPermutationsNumber()...};
+
+		static constexpr size_t weight(size_t i) {
+			size_t weight = 1;
+			for(size_t j = 0; j < i; ++j) {
+				weight *= SIZES[j];
+			}
+			return weight;
+		}
+
+		template<size_t... Is>
+		static constexpr std::tuple<std::array<unsigned int, nbrElements>...> unrank_impl(size_t rank, std::index_sequence<Is...>) {
+			return std::tuple<std::array<unsigned int, nbrElements>...>(PermutationGenerator<nbrElements>::unrank(rank / weight(Is) % SIZES[Is])...);
+		}
+
+		template<size_t... Is>
+		static constexpr size_t rank_impl(const std::tuple<std::array<unsigned int, nbrElements>...>& permutations, std::index_sequence<Is...>) {
+			return ((PermutationGenerator<nbrElements>::rank(std::get<Is>(permutations)) * weight(Is)) + ...);
+		}
+
 		template<typename Func>
 		void apply(Func func) {
 			apply_impl(func, std::make_index_sequence<sizeof...(nbrElements)>());
@@ -217,6 +317,92 @@ namespace segre {
 		bool m_finished;
 	};
 
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Permutations of ranks [begin, end) of a generator.
+	 *
+	 * @details    Each permutation is unranked independently, so disjoint
+	 *             ranges can be iterated concurrently without sharing a
+	 *             generator.
+	 *
+	 * @tparam     Generator  PermutationGenerator or MultiPermutationGenerator
+	 */
+	template<typename Generator>
+	class PermutationRange {
+
+	public:
+
+		using value_type = decltype(Generator::unrank(0));
+
+		class iterator {
+
+		public:
+
+			using iterator_category = std::input_iterator_tag;
+			using value_type = PermutationRange::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const value_type*;
+			using reference = value_type;
+
+			constexpr explicit iterator(size_t rank) noexcept
+			  : m_rank(rank) {
+
+			}
+
+			constexpr value_type operator*() const {
+				return Generator::unrank(m_rank);
+			}
+
+			constexpr iterator& operator++() noexcept {
+				++m_rank;
+				return *this;
+			}
+
+			constexpr size_t rank() const noexcept {
+				return m_rank;
+			}
+
+			constexpr bool operator==(const iterator& other) const noexcept {
+				return m_rank == other.m_rank;
+			}
+
+			constexpr bool operator!=(const iterator& other) const noexcept {
+				return m_rank != other.m_rank;
+			}
+
+		private:
+
+			size_t m_rank;
+		};
+
+		constexpr PermutationRange() noexcept
+		  : PermutationRange(0, Generator::getPermutationsNumber()) {
+
+		}
+
+		constexpr PermutationRange(size_t begin, size_t end) noexcept
+		  : m_begin(begin)
+		  , m_end(end) {
+
+		}
+
+		constexpr iterator begin() const noexcept {
+			return iterator(m_begin);
+		}
+
+		constexpr iterator end() const noexcept {
+			return iterator(m_end);
+		}
+
+		constexpr size_t size() const noexcept {
+			return m_end - m_begin;
+		}
+
+	private:
+
+		size_t m_begin;
+		size_t m_end;
+	};
+
 }
 
 
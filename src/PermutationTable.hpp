@@ -0,0 +1,384 @@
+#ifndef HYPERPLANEFINDER_PERMUTATIONTABLE_HPP
+#define HYPERPLANEFINDER_PERMUTATIONTABLE_HPP
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "impossible.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define HYPERPLANEFINDER_HAS_MMAP
+#endif
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Memory layout of a PermutationTable.
+	 */
+	enum class PermutationTableLayout : std::uint32_t {
+		RowMajor,   ///< The permutations of an hyperplane are contiguous
+		ColumnMajor ///< The hyperplanes of a permutation are contiguous
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Permutations table stored in a single contiguous array.
+	 *
+	 * @details    Element (@c h, @c p) is the id of the hyperplane obtained by
+	 *             applying permutation @c p to hyperplane @c h.
+	 *
+	 *             A table can be saved to a file and loaded back, the file is
+	 *             memory mapped when the platform allows it (the table is then
+	 *             read only) and read otherwise. The file is a 32 bytes header
+	 *             (magic, id size, layout, hyperplanes number, permutations
+	 *             number) followed by the ids in native endianness.
+	 *
+	 * @tparam     Id    Unsigned type of the hyperplanes ids, std::uint16_t or
+	 *                   std::uint32_t
+	 */
+	template<typename Id>
+	class PermutationTable {
+
+		static_assert(std::is_unsigned_v<Id>, "Hyperplanes ids are unsigned");
+
+	public:
+
+		PermutationTable() noexcept;
+
+		PermutationTable(size_t nbr_hyperplanes, size_t nbr_permutations, PermutationTableLayout layout = PermutationTableLayout::RowMajor);
+
+		PermutationTable(const PermutationTable<Id>&) = delete;
+		PermutationTable<Id>& operator=(const PermutationTable<Id>&) = delete;
+
+		PermutationTable(PermutationTable<Id>&&) noexcept = default;
+		PermutationTable<Id>& operator=(PermutationTable<Id>&&) noexcept = default;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Check whether @p nbr_hyperplanes ids fit in @p Id.
+		 */
+		static constexpr bool canHold(size_t nbr_hyperplanes);
+
+		Id operator()(size_t hyperplane, size_t permutation) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Set element (@p hyperplane, @p permutation), the program is
+		 *             stopped if the table is memory mapped.
+		 */
+		void set(size_t hyperplane, size_t permutation, Id id);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Get the permutations of an hyperplane, the program is
+		 *             stopped if the layout isn't row major.
+		 */
+		const Id* getRow(size_t hyperplane) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Get the images of all hyperplanes by a permutation, the
+		 *             program is stopped if the layout isn't column major.
+		 */
+		const Id* getColumn(size_t permutation) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Copy the table to the other layout.
+		 */
+		PermutationTable<Id> transposed() const;
+
+		size_t getHyperplanesNumber() const;
+
+		size_t getPermutationsNumber() const;
+
+		PermutationTableLayout getLayout() const;
+
+		bool isMapped() const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Save the table to a file.
+		 *
+		 * @param[in]  path  The file path
+		 *
+		 * @return     False and a message on std::cerr if the file couldn't be
+		 *             written
+		 */
+		bool save(const std::string& path) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Replace the table by the one saved in a file, memory
+		 *             mapped if possible.
+		 *
+		 * @param[in]  path  The file path
+		 *
+		 * @return     False and a message on std::cerr if the file couldn't be
+		 *             read or doesn't hold a table of @p Id, the table is then
+		 *             left unchanged
+		 */
+		bool load(const std::string& path);
+
+	private:
+
+		static constexpr size_t HEADER_SIZE = 32;
+		static constexpr char MAGIC[8] = {'H', 'F', 'P', 'T', 'A', 'B', 'L', 'E'};
+
+		size_t position(size_t hyperplane, size_t permutation) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Check a file header against the file size and get the
+		 *             table dimensions, the table isn't modified.
+		 */
+		static bool parseHeader(
+		  const char* header,
+		  const std::string& path,
+		  size_t file_size,
+		  size_t& nbr_hyperplanes,
+		  size_t& nbr_permutations,
+		  PermutationTableLayout& layout
+		);
+
+		size_t m_nbr_hyperplanes;
+		size_t m_nbr_permutations;
+		PermutationTableLayout m_layout;
+		std::vector<Id> m_ids;
+		std::shared_ptr<const void> m_mapping; ///< Keeps the file mapping alive, null if not mapped
+		const Id* m_data;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	template<typename Id>
+	PermutationTable<Id>::PermutationTable() noexcept
+	  : m_nbr_hyperplanes(0)
+	  , m_nbr_permutations(0)
+	  , m_layout(PermutationTableLayout::RowMajor)
+	  , m_ids()
+	  , m_mapping()
+	  , m_data(nullptr) {
+
+	}
+
+	template<typename Id>
+	PermutationTable<Id>::PermutationTable(size_t nbr_hyperplanes, size_t nbr_permutations, PermutationTableLayout layout)
+	  : m_nbr_hyperplanes(nbr_hyperplanes)
+	  , m_nbr_permutations(nbr_permutations)
+	  , m_layout(layout)
+	  , m_ids(nbr_hyperplanes * nbr_permutations)
+	  , m_mapping()
+	  , m_data(m_ids.data()) {
+
+	}
+
+	template<typename Id>
+	constexpr bool PermutationTable<Id>::canHold(size_t nbr_hyperplanes) {
+		return nbr_hyperplanes == 0 || nbr_hyperplanes - 1 <= std::numeric_limits<Id>::max();
+	}
+
+	template<typename Id>
+	Id PermutationTable<Id>::operator()(size_t hyperplane, size_t permutation) const {
+		return m_data[position(hyperplane, permutation)];
+	}
+
+	template<typename Id>
+	void PermutationTable<Id>::set(size_t hyperplane, size_t permutation, Id id) {
+		// A memory mapped table is read only, its ids aren't in m_ids
+		if(isMapped() || hyperplane >= m_nbr_hyperplanes || permutation >= m_nbr_permutations) {
+			IMPOSSIBLE;
+		}
+		m_ids[position(hyperplane, permutation)] = id;
+	}
+
+	template<typename Id>
+	const Id* PermutationTable<Id>::getRow(size_t hyperplane) const {
+		if(m_layout != PermutationTableLayout::RowMajor || hyperplane >= m_nbr_hyperplanes) {
+			IMPOSSIBLE;
+		}
+		return m_data + hyperplane * m_nbr_permutations;
+	}
+
+	template<typename Id>
+	const Id* PermutationTable<Id>::getColumn(size_t permutation) const {
+		if(m_layout != PermutationTableLayout::ColumnMajor || permutation >= m_nbr_permutations) {
+			IMPOSSIBLE;
+		}
+		return m_data + permutation * m_nbr_hyperplanes;
+	}
+
+	template<typename Id>
+	PermutationTable<Id> PermutationTable<Id>::transposed() const {
+		PermutationTable<Id> table(m_nbr_hyperplanes, m_nbr_permutations, m_layout == PermutationTableLayout::RowMajor ? PermutationTableLayout::ColumnMajor : PermutationTableLayout::RowMajor);
+		for(size_t h = 0; h < m_nbr_hyperplanes; ++h) {
+			for(size_t p = 0; p < m_nbr_permutations; ++p) {
+				table.set(h, p, (*this)(h, p));
+			}
+		}
+		return table;
+	}
+
+	template<typename Id>
+	size_t PermutationTable<Id>::getHyperplanesNumber() const {
+		return m_nbr_hyperplanes;
+	}
+
+	template<typename Id>
+	size_t PermutationTable<Id>::getPermutationsNumber() const {
+		return m_nbr_permutations;
+	}
+
+	template<typename Id>
+	PermutationTableLayout PermutationTable<Id>::getLayout() const {
+		return m_layout;
+	}
+
+	template<typename Id>
+	bool PermutationTable<Id>::isMapped() const {
+		return m_mapping != nullptr;
+	}
+
+	template<typename Id>
+	bool PermutationTable<Id>::save(const std::string& path) const {
+		char header[HEADER_SIZE] = {};
+		const std::uint32_t id_size = sizeof(Id);
+		const std::uint32_t layout = static_cast<std::uint32_t>(m_layout);
+		const std::uint64_t nbr_hyperplanes = m_nbr_hyperplanes;
+		const std::uint64_t nbr_permutations = m_nbr_permutations;
+		std::memcpy(header, MAGIC, sizeof(MAGIC));
+		std::memcpy(header + 8, &id_size, sizeof(id_size));
+		std::memcpy(header + 12, &layout, sizeof(layout));
+		std::memcpy(header + 16, &nbr_hyperplanes, sizeof(nbr_hyperplanes));
+		std::memcpy(header + 24, &nbr_permutations, sizeof(nbr_permutations));
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(header, HEADER_SIZE);
+		file.write(reinterpret_cast<const char*>(m_data), static_cast<std::streamsize>(m_nbr_hyperplanes * m_nbr_permutations * sizeof(Id)));
+		if(!file) {
+			std::cerr << "Failed to write permutations table " << path << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	template<typename Id>
+	bool PermutationTable<Id>::load(const std::string& path) {
+		// The table is only modified once the whole file has been checked and read
+		size_t nbr_hyperplanes = 0;
+		size_t nbr_permutations = 0;
+		PermutationTableLayout layout = PermutationTableLayout::RowMajor;
+#ifdef HYPERPLANEFINDER_HAS_MMAP
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if(fd >= 0) {
+			struct stat file_stat;
+			void* mapping = MAP_FAILED;
+			size_t file_size = 0;
+			if(::fstat(fd, &file_stat) == 0 && file_stat.st_size >= static_cast<off_t>(HEADER_SIZE)) {
+				file_size = static_cast<size_t>(file_stat.st_size);
+				mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			}
+			::close(fd);
+
+			if(mapping != MAP_FAILED) {
+				std::shared_ptr<const void> holder(mapping, [file_size](const void* address) {
+					::munmap(const_cast<void*>(address), file_size);
+				});
+				if(!parseHeader(static_cast<const char*>(mapping), path, file_size, nbr_hyperplanes, nbr_permutations, layout)) {
+					return false;
+				}
+				m_nbr_hyperplanes = nbr_hyperplanes;
+				m_nbr_permutations = nbr_permutations;
+				m_layout = layout;
+				m_ids.clear();
+				m_ids.shrink_to_fit();
+				m_mapping = std::move(holder);
+				m_data = reinterpret_cast<const Id*>(static_cast<const char*>(mapping) + HEADER_SIZE);
+				return true;
+			}
+		}
+		// Fall back to reading the file
+#endif
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if(!file) {
+			std::cerr << "Failed to open permutations table " << path << std::endl;
+			return false;
+		}
+		const size_t file_size = static_cast<size_t>(file.tellg());
+		file.seekg(0);
+		char header[HEADER_SIZE] = {};
+		if(!file.read(header, HEADER_SIZE)) {
+			std::cerr << "Failed to read permutations table " << path << std::endl;
+			return false;
+		}
+		if(!parseHeader(header, path, file_size, nbr_hyperplanes, nbr_permutations, layout)) {
+			return false;
+		}
+		std::vector<Id> ids(nbr_hyperplanes * nbr_permutations);
+		if(!file.read(reinterpret_cast<char*>(ids.data()), static_cast<std::streamsize>(ids.size() * sizeof(Id)))) {
+			std::cerr << "Failed to read permutations table " << path << std::endl;
+			return false;
+		}
+		m_nbr_hyperplanes = nbr_hyperplanes;
+		m_nbr_permutations = nbr_permutations;
+		m_layout = layout;
+		m_ids = std::move(ids);
+		m_mapping.reset();
+		m_data = m_ids.data();
+		return true;
+	}
+
+	template<typename Id>
+	size_t PermutationTable<Id>::position(size_t hyperplane, size_t permutation) const {
+		return m_layout == PermutationTableLayout::RowMajor
+		       ? hyperplane * m_nbr_permutations + permutation
+		       : permutation * m_nbr_hyperplanes + hyperplane;
+	}
+
+	template<typename Id>
+	bool PermutationTable<Id>::parseHeader(
+	  const char* header,
+	  const std::string& path,
+	  size_t file_size,
+	  size_t& nbr_hyperplanes,
+	  size_t& nbr_permutations,
+	  PermutationTableLayout& layout
+	) {
+		std::uint32_t header_id_size;
+		std::uint32_t header_layout;
+		std::uint64_t header_nbr_hyperplanes;
+		std::uint64_t header_nbr_permutations;
+		std::memcpy(&header_id_size, header + 8, sizeof(header_id_size));
+		std::memcpy(&header_layout, header + 12, sizeof(header_layout));
+		std::memcpy(&header_nbr_hyperplanes, header + 16, sizeof(header_nbr_hyperplanes));
+		std::memcpy(&header_nbr_permutations, header + 24, sizeof(header_nbr_permutations));
+
+		// A forged or corrupted header mustn't overflow the expected file size
+		const std::uint64_t max_ids = (std::numeric_limits<std::uint64_t>::max() - HEADER_SIZE) / sizeof(Id);
+		const bool overflow = header_nbr_permutations != 0 && header_nbr_hyperplanes > max_ids / header_nbr_permutations;
+
+		if(std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0
+		   || header_id_size != sizeof(Id)
+		   || header_layout > static_cast<std::uint32_t>(PermutationTableLayout::ColumnMajor)
+		   || overflow
+		   || file_size != HEADER_SIZE + header_nbr_hyperplanes * header_nbr_permutations * sizeof(Id)) {
+			std::cerr << "Invalid permutations table " << path << std::endl;
+			return false;
+		}
+
+		nbr_hyperplanes = header_nbr_hyperplanes;
+		nbr_permutations = header_nbr_permutations;
+		layout = static_cast<PermutationTableLayout>(header_layout);
+		return true;
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_PERMUTATIONTABLE_HPP
@@ -11,26 +11,19 @@
 #include <map>
 #include <iostream>
 #include <set>
+#include <cstdint>
 
+#include "BitsetWords.hpp"
 #include "CombinationGenerator.hpp"
 #include "math.hpp"
 #include "impossible.hpp"
+#include "LayerTuple.hpp"
+#include "EntriesCounter.hpp"
+#include "HyperplaneIndex.hpp"
+#include "ParallelFor.hpp"
 #include "HyperplaneTableEntry.hpp"
 #include "VeldkampLineTableEntry.hpp"
-
-// Fixme : Replace std::bitset by a custom bitset
-namespace std { // NOLINT
-	template <size_t N>
-	bool operator<(const std::bitset<N>& x, const std::bitset<N>& y) {
-		for (size_t i = N - 1; i--;) {
-			if (x[i] ^ y[i]) {
-				return y[i];
-			}
-		}
-
-		return false;
-	}
-}
+#include "HyperplaneWords.hpp"
 
 namespace segre {
 
@@ -45,6 +38,15 @@ namespace segre {
 		std::vector<std::array<unsigned int, NbrPointsPerLine>> projectives;
 	};
 
+	/**
+	 * An orbit of veldkamp lines under the symmetry group of the geometry (see computeVeldkampLineOrbits()).
+	 */
+	template <std::size_t NbrPointsPerLine>
+	struct VeldkampLineOrbit {
+		std::array<unsigned int, NbrPointsPerLine> representative; // sorted ids of the hyperplanes of a line of the orbit
+		size_t size;
+	};
+
 	template <
 	  size_t Dimension,
 	  size_t NbrPointsPerLine,
@@ -88,6 +90,19 @@ namespace segre {
 		  const std::vector<std::bitset<NbrPoints>>& veldkampPoints
 		) const noexcept;
 
+		/**
+		 * Computes the veldkamp lines of the geometry as computeVeldkampLines(), the same lines in the same order. The
+		 * hyperplanes having the same core with a pair are searched by tiles: a block of pairs is tested against each
+		 * block of hyperplanes small enough to stay in the L1 cache, read from a word-major copy of the hyperplanes
+		 * (see HyperplaneWords) so that the test vectorizes over the hyperplanes.
+		 *
+		 * @param veldkampPoints the hyperplanes of the geometry.
+		 * @return A struct containing the projective lines and the supposed exceptional lines.
+		 */
+		VeldkampLines<NbrPointsPerLine> computeVeldkampLinesTiled(
+		  const std::vector<std::bitset<NbrPoints>>& veldkampPoints
+		) const noexcept;
+
 		/**
 		 * Excludes the projectives lines from the list of exceptional lines.
 		 * @param vLines a struct containing the projective and exceptional lines.
@@ -100,6 +115,60 @@ namespace segre {
 		  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
 		) const;
 
+		/**
+		 * Computes the veldkamp lines table of the geometry in a single pass: each line is classified as projective
+		 * or exceptional and added to the table as soon as it is found, without intermediate lines lists.
+		 *
+		 * @param vPoints the hyperplanes of the geometry.
+		 * @param vPoints_types the type of each hyperplane of vPoints (see HyperplanesTable).
+		 * @param nextGeometry the next geometry used to build the matrix associated to the hyperplanes.
+		 * @return the lines table (the lines of the entries are kept if WithLines is true) and the projective lines.
+		 */
+		template <bool WithLines>
+		VeldkampLinesTable<NbrPointsPerLine> computeVeldkampLinesTable(
+		  const std::vector<std::bitset<NbrPoints>>& vPoints,
+		  const std::vector<unsigned int>& vPoints_types,
+		  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
+		) const;
+
+		/**
+		 * Computes the veldkamp lines table of the geometry from the orbits of its lines under the symmetry group:
+		 * each orbit is classified through its representative and counted with its size. The entries are the ones
+		 * of computeVeldkampLinesTable(), in the order of the orbits.
+		 *
+		 * @param orbits the orbits of the veldkamp lines (see computeVeldkampLineOrbits()).
+		 * @param vPoints the hyperplanes of the geometry.
+		 * @param vPoints_types the type of each hyperplane of vPoints (see HyperplanesTable).
+		 * @param nextGeometry the next geometry used to build the matrix associated to the hyperplanes.
+		 * @return the lines table.
+		 */
+		std::vector<VeldkampLineTableEntry> makeVeldkampLinesTable(
+		  const std::vector<VeldkampLineOrbit<NbrPointsPerLine>>& orbits,
+		  const std::vector<std::bitset<NbrPoints>>& vPoints,
+		  const std::vector<unsigned int>& vPoints_types,
+		  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
+		) const;
+
+		/**
+		 * Checks if the matrix associated to the hyperplane of the next geometry made of a veldkamp line isn't of full
+		 * rank, which makes a supposed exceptional line projective.
+		 *
+		 * @param line a veldkamp line.
+		 * @param vPoints the hyperplanes of the geometry.
+		 * @param nextGeometry the next geometry used to build the matrix associated to the hyperplanes.
+		 * @return true if the rank of the matrix is lesser than pow(2, Dimension + 1).
+		 */
+		bool hasDegenerateMatrix(
+		  const std::array<unsigned int, NbrPointsPerLine>& line,
+		  const std::vector<std::bitset<NbrPoints>>& vPoints,
+		  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
+		) const;
+
+		bool hasDegenerateMatrix(
+		  const std::array<std::bitset<NbrPoints>, NbrPointsPerLine>& hyperplanes,
+		  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
+		) const;
+
 		size_t getRank(std::vector<std::array<unsigned int, math::pow(2UL, Dimension + 1)>>&& matrix) const;
 
 		decltype(auto) computeHyperplanesFromVeldkampLines(
@@ -107,6 +176,20 @@ namespace segre {
 		  const std::vector<std::array<unsigned int, NbrPointsPerLine>>& pVLines
 		);
 
+		/**
+		 * Computes the hyperplanes of the next geometry using the projective veldkamp lines of the current geometry,
+		 * in their compact layer tuple form (see LayerTuple).
+		 *
+		 * @param veldkampPoints the hyperplanes of the current geometry, the layers are indexes in this vector.
+		 * @param pVLines the projective veldkamp lines of the current geometry.
+		 * @return the layer tuples of the hyperplanes of the next geometry, in the same order as
+		 * 	computeHyperplanesFromVeldkampLines().
+		 */
+		static std::vector<LayerTuple<NbrPointsPerLine>> computeLayerTuplesFromVeldkampLines(
+		  const std::vector<std::bitset<NbrPoints>>& veldkampPoints,
+		  const std::vector<std::array<unsigned int, NbrPointsPerLine>>& pVLines
+		);
+
 		/**
 		 * Returns the hyperplanes of the given veldkamp line.
 		 * @param veldkampPoints list of all the veldkamp points of the current geometry.
@@ -127,44 +210,113 @@ namespace segre {
 		) const noexcept;
 
 		template <bool OrderOfPoints>
-		HyperplaneTableEntry getHyperplaneTableEntry(
+		FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine> getHyperplaneTableEntry(
 		  const std::bitset<NbrPoints>& hyperplane
 		) const noexcept;
 
-		template <bool OrderOfPoints>
-		HyperplaneTableEntry getHyperplaneTableEntry(
+		/**
+		 * Extracts a sub geometry of an hyperplane: the points having their coordinate of the given direction
+		 * equal to the given slice, in the point order of the geometry of dimension Dimension - 1.
+		 *
+		 * @param hyperplane an hyperplane of the geometry.
+		 * @param direction the direction fixed by the sub geometry.
+		 * @param slice the value of the coordinate of the fixed direction.
+		 * @return the sub geometry, an hyperplane or the full geometry of dimension Dimension - 1.
+		 */
+		std::bitset<NbrPoints / NbrPointsPerLine> extractSubGeometry(
 		  const std::bitset<NbrPoints>& hyperplane,
-		  const std::vector<HyperplaneTableEntry>& precedent_table
+		  size_t direction,
+		  size_t slice
 		) const noexcept;
 
+		/**
+		 * Identifies all the sub geometries of an hyperplane in the hyperplanes catalog of the previous dimension.
+		 *
+		 * @param hyperplane an hyperplane of the geometry.
+		 * @param precedent_index index of the hyperplanes of the previous dimension.
+		 * @return for each direction, the ids of its sub geometries (LayerTuple::FULL for a full sub geometry).
+		 */
+		std::array<LayerTuple<NbrPointsPerLine>, Dimension> getSubGeometriesIds(
+		  const std::bitset<NbrPoints>& hyperplane,
+		  const HyperplaneIndex<math::pow(NbrPointsPerLine, Dimension - 1)>& precedent_index
+		) const noexcept;
+
+		/**
+		 * Computes the hyperplane table entry of an hyperplane, with its sub geometries statistics.
+		 *
+		 * @param hyperplane an hyperplane of the geometry.
+		 * @param precedent_index index of the hyperplanes of the previous dimension.
+		 * @param precedent_types for each hyperplane of the previous dimension, its entry number in the previous
+		 * 	dimension hyperplanes table (see HyperplanesTable).
+		 * @return the hyperplane table entry.
+		 */
 		template <bool OrderOfPoints>
-		std::vector<HyperplaneTableEntry> makeHyperplaneTable(
+		FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine> getHyperplaneTableEntry(
+		  const std::bitset<NbrPoints>& hyperplane,
+		  const HyperplaneIndex<math::pow(NbrPointsPerLine, Dimension - 1)>& precedent_index,
+		  const std::vector<unsigned int>& precedent_types
+		) const noexcept;
+
+		/**
+		 * Computes the hyperplanes table of the geometry. With a parallel backend, each worker builds the partial
+		 * table of a contiguous chunk of vPoints and the partial tables are merged in order: the table is the same
+		 * as the one of a sequential run.
+		 *
+		 * @param vPoints the hyperplanes of the geometry.
+		 * @return the hyperplanes table, with the type of each hyperplane of vPoints.
+		 */
+		template <bool OrderOfPoints, ParallelBackend Backend = ParallelBackend::Sequential>
+		HyperplanesTable makeHyperplaneTable(
 		  const std::vector<std::bitset<NbrPoints>>& vPoints
 		) const noexcept;
 
-		template <bool OrderOfPoints>
-		std::vector<HyperplaneTableEntry> makeHyperplaneTable(
+		template <bool OrderOfPoints, ParallelBackend Backend = ParallelBackend::Sequential>
+		HyperplanesTable makeHyperplaneTable(
 		  const std::vector<std::bitset<NbrPoints>>& vPoints,
-		  const std::vector<HyperplaneTableEntry>& precedent_table
+		  const HyperplaneIndex<math::pow(NbrPointsPerLine, Dimension - 1)>& precedent_index,
+		  const std::vector<unsigned int>& precedent_types
 		) const noexcept;
 
-		VeldkampLineTableEntry makeLinesTableEntry(
+		/**
+		 * Computes the lines table entry of a veldkamp line.
+		 *
+		 * @param isProjective true if the line is projective.
+		 * @param line the veldkamp line.
+		 * @param vPoints the hyperplanes of the geometry.
+		 * @param vPoints_types the type of each hyperplane of vPoints (see HyperplanesTable).
+		 * @return the lines table entry.
+		 */
+		FlatVeldkampLineTableEntry<NbrPointsPerLine> makeLinesTableEntry(
 		  bool isProjective,
 		  const std::array<unsigned int, NbrPointsPerLine>& line,
 		  const std::vector<std::bitset<NbrPoints>>& vPoints,
-		  const std::vector<HyperplaneTableEntry>& points_table
+		  const std::vector<unsigned int>& vPoints_types
+		) const noexcept;
+
+		/**
+		 * Computes the lines table entry of a veldkamp line from its core.
+		 *
+		 * @param isProjective true if the line is projective.
+		 * @param core the intersection of the hyperplanes of the line.
+		 * @param types the types of the hyperplanes of the line (see HyperplanesTable).
+		 * @return the lines table entry.
+		 */
+		FlatVeldkampLineTableEntry<NbrPointsPerLine> makeLinesTableEntry(
+		  bool isProjective,
+		  const std::bitset<NbrPoints>& core,
+		  const std::array<unsigned int, NbrPointsPerLine>& types
 		) const noexcept;
 
 		std::vector<VeldkampLineTableEntry> makeVeldkampLinesTable(
 		  VeldkampLines<NbrPointsPerLine>& vLines,
 		  const std::vector<std::bitset<NbrPoints>>& vPoints,
-		  const std::vector<HyperplaneTableEntry>& points_table
+		  const std::vector<unsigned int>& vPoints_types
 		) const noexcept;
 
 		std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> makeVeldkampLinesTableWithLines(
 		  const VeldkampLines<NbrPointsPerLine>& vLines,
 		  const std::vector<std::bitset<NbrPoints>>& vPoints,
-		  const std::vector<HyperplaneTableEntry>& points_table
+		  const std::vector<unsigned int>& vPoints_types
 		) const noexcept;
 
 	private:
@@ -174,10 +326,24 @@ namespace segre {
 
 		void computeMasks();
 
+		/**
+		 * Merges partial hyperplanes tables, in order.
+		 *
+		 * @param partial_tables the partial tables, partial_tables[i] made from the chunk i of parallelChunks().
+		 * @param types the type of each hyperplane in the partial table of its chunk.
+		 * @return the hyperplanes table.
+		 */
+		template <ParallelBackend Backend>
+		static HyperplanesTable mergeHyperplaneTables(
+		  const std::vector<EntriesCounter<FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>>>& partial_tables,
+		  std::vector<unsigned int>&& types
+		);
+
 		std::array<std::bitset<NbrPoints>, NbrLines> m_geometryLines;
 		std::array<std::array<unsigned int, TensorSize>, NbrPoints> m_geometryPoints;
 
 		std::array<std::array<std::bitset<NbrPoints>, NbrPointsPerLine>, Dimension> m_subGeometriesMasks;
+		std::array<std::array<std::array<unsigned int, math::pow(NbrPointsPerLine, Dimension - 1)>, NbrPointsPerLine>, Dimension> m_subGeometriesPoints;
 	};
 }
 
@@ -185,16 +351,6 @@ namespace segre {
 
 	const std::array<std::array<unsigned int, 2>, 4> TENSOR_2D = {{ {{1, 0}}, {{0, 1}}, {{1, 1}}, {{1, 2}} }};
 
-	template <size_t N1, size_t N2>
-	inline std::bitset<N1> copyBitset(const std::bitset<N2>& bs2) {
-		std::bitset<N1> bs1;
-		for (size_t i = 0; i < N2; i++) {
-			bs1[i] = bs2[i];
-		}
-
-		return bs1;
-	}
-
 	template <std::size_t NbrPointsPerLine>
 	VeldkampLines<NbrPointsPerLine>::VeldkampLines(
 	  std::vector<std::array<unsigned int, NbrPointsPerLine>>&& exceptional_lines,
@@ -211,7 +367,8 @@ namespace segre {
 	) noexcept
 	  : m_geometryLines(std::move(lines))
 	  , m_geometryPoints(TENSOR_2D)
-	  , m_subGeometriesMasks() {
+	  , m_subGeometriesMasks()
+	  , m_subGeometriesPoints() {
 
 		computeMasks();
 	}
@@ -223,7 +380,8 @@ namespace segre {
 	) noexcept
 	  : m_geometryLines(std::move(lines))
 	  , m_geometryPoints(std::move(tensors))
-	  , m_subGeometriesMasks() {
+	  , m_subGeometriesMasks()
+	  , m_subGeometriesPoints() {
 
 		computeMasks();
 	}
@@ -328,6 +486,117 @@ namespace segre {
 		return VeldkampLines<NbrPointsPerLine>{std::move(supposedExceptional), std::move(projectiveLines)};
 	}
 
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	VeldkampLines<NbrPointsPerLine> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::computeVeldkampLinesTiled(
+	  const std::vector<std::bitset<NbrPoints>>& veldkampPoints
+	) const noexcept {
+
+		constexpr size_t Words = HyperplaneWords<NbrPoints>::WORDS;
+		constexpr size_t Padding = HyperplaneWords<NbrPoints>::PADDING;
+		// Hyperplanes of a tile: 16 KiB of words, half of a common L1 data cache
+		constexpr size_t TileSize = std::max((size_t{16} << 10U) / (Words * sizeof(std::uint64_t)) / Padding * Padding, Padding);
+		// Pairs tested against a tile while it is in cache
+		constexpr size_t TilePairs = 256;
+
+		struct Pair {
+			unsigned int a;
+			unsigned int b;
+			std::array<std::uint64_t, Words> span; // a | b, (h & span) == core if and only if h has the same core with a and b
+			std::array<std::uint64_t, Words> core;
+		};
+
+		std::vector<std::array<unsigned int, NbrPointsPerLine>> supposedExceptional;
+		std::vector<std::array<unsigned int, NbrPointsPerLine>> projectiveLines;
+
+		const HyperplaneWords<NbrPoints> words(veldkampPoints);
+		const unsigned int nbr_hyperplanes = static_cast<unsigned int>(veldkampPoints.size());
+
+		std::vector<Pair> pairs;
+		pairs.reserve(TilePairs);
+		std::vector<std::vector<unsigned int>> sameCores(TilePairs);
+
+		unsigned int a = 0;
+		unsigned int b = 1;
+		while (b < nbr_hyperplanes) {
+			// Next block of pairs, in the order of computeVeldkampLines()
+			pairs.clear();
+			while (pairs.size() < TilePairs && b < nbr_hyperplanes) {
+				Pair pair;
+				pair.a = a;
+				pair.b = b;
+				const std::array<std::uint64_t, Words> wordsA = toWords(veldkampPoints[a]);
+				const std::array<std::uint64_t, Words> wordsB = toWords(veldkampPoints[b]);
+				for (size_t w = 0; w < Words; ++w) {
+					pair.span[w] = wordsA[w] | wordsB[w];
+					pair.core[w] = wordsA[w] & wordsB[w];
+				}
+				pairs.push_back(pair);
+
+				if (++b == nbr_hyperplanes) {
+					++a;
+					b = a + 1;
+				}
+			}
+
+			for (size_t p = 0; p < pairs.size(); ++p) {
+				sameCores[p].clear();
+			}
+			for (size_t first = 0; first < words.getPaddedSize(); first += TileSize) {
+				const size_t tileSize = std::min(TileSize, words.getPaddedSize() - first);
+				for (size_t p = 0; p < pairs.size(); ++p) {
+					const Pair& pair = pairs[p];
+					const auto hasSameCore = [&words, &pair](size_t i) {
+						std::uint64_t difference = 0;
+						for (size_t w = 0; w < Words; ++w) {
+							difference |= (words.getColumn(w)[i] & pair.span[w]) ^ pair.core[w];
+						}
+						return difference == 0;
+					};
+
+					// Few hyperplanes have the same core: the blocks are reduced and only the matching ones are scanned
+					for (size_t block = first; block < first + tileSize; block += Padding) {
+						std::uint64_t anyMatch = 0;
+						for (size_t i = block; i < block + Padding; ++i) {
+							anyMatch |= hasSameCore(i);
+						}
+						if (anyMatch == 0) {
+							continue;
+						}
+						for (size_t i = block; i < block + Padding; ++i) {
+							if (hasSameCore(i)) {
+								sameCores[p].push_back(static_cast<unsigned int>(i));
+							}
+						}
+					}
+				}
+			}
+
+			for (size_t p = 0; p < pairs.size(); ++p) {
+				const std::vector<unsigned int>& sameCore = sameCores[p];
+				const std::bitset<NbrPoints> core = veldkampPoints[pairs[p].a] & veldkampPoints[pairs[p].b];
+				for (size_t c = 0; c < sameCore.size(); ++c) {
+					if (sameCore[c] <= pairs[p].b) {
+						continue;
+					}
+					for (size_t d = c + 1; d < sameCore.size(); ++d) {
+						if ((veldkampPoints[sameCore[c]] & veldkampPoints[sameCore[d]]) != core) {
+							continue;
+						}
+
+						const std::array<unsigned int, NbrPointsPerLine> line = {{pairs[p].a, pairs[p].b, sameCore[c], sameCore[d]}};
+						if (sameCore.size() == 2) {
+							projectiveLines.push_back(line);
+						} else {
+							supposedExceptional.push_back(line);
+						}
+					}
+				}
+			}
+		}
+
+		return VeldkampLines<NbrPointsPerLine>{std::move(supposedExceptional), std::move(projectiveLines)};
+	}
+
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
 	void PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::distinguishVeldkampLines(
 	  VeldkampLines<NbrPointsPerLine>& vLines,
@@ -341,10 +610,11 @@ namespace segre {
 		// Checks the rank of the matrix associated to each hyperplane.
 		// If the rank of the matrix is lesser than pow(2, Dimension + 1) then the line isn't exceptional.
 		for (size_t index = 0; index < vLines.exceptional.size(); ++index) {
-			std::bitset<NewNbrPoints> hyperplane;
-			for (size_t i = 0; i < vLines.exceptional[index].size(); ++i) {
-				hyperplane |= copyBitset<NewNbrPoints>(vPoints[vLines.exceptional[index][i]]) <<= (i * NbrPoints);
+			std::array<std::bitset<NbrPoints>, NbrPointsPerLine> layers;
+			for (size_t i = 0; i < NbrPointsPerLine; ++i) {
+				layers[i] = vPoints[vLines.exceptional[index][i]];
 			}
+			const std::bitset<NewNbrPoints> hyperplane = concatenateLayers(layers);
 
 			// Checks if the matrix associated to the hyperplane live in the projective space.
 			if (getRank(nextGeometry.buildMatrix(hyperplane)) < math::pow(2UL, Dimension + 1)) {
@@ -363,6 +633,153 @@ namespace segre {
 		}
 	}
 
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	template<bool WithLines>
+	VeldkampLinesTable<NbrPointsPerLine> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::computeVeldkampLinesTable(
+	  const std::vector<std::bitset<NbrPoints>>& vPoints,
+	  const std::vector<unsigned int>& vPoints_types,
+	  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
+	) const {
+
+		VeldkampLinesTable<NbrPointsPerLine> table;
+		EntriesCounter<FlatVeldkampLineTableEntry<NbrPointsPerLine>> entries;
+		std::vector<std::vector<std::array<unsigned int, NbrPointsPerLine>>> entries_lines;
+
+		std::vector<unsigned int> sameCore;
+		for (unsigned int a = 0; a < vPoints.size(); ++a) {
+			for (unsigned int b = a + 1; b < vPoints.size(); ++b) {
+				const std::bitset<NbrPoints> core = vPoints[a] & vPoints[b];
+
+				// Hyperplanes having the same core with a and b
+				sameCore.clear();
+				for (unsigned int i = 0; i < vPoints.size(); ++i) {
+					if ((vPoints[a] & vPoints[i]) == core && (vPoints[b] & vPoints[i]) == core) {
+						sameCore.push_back(i);
+					}
+				}
+
+				// Core statistics, shared by the lines of (a, b)
+				bool coreComputed = false;
+				unsigned int coreNbrLines = 0;
+
+				for (size_t c = 0; c < sameCore.size(); ++c) {
+					if (sameCore[c] <= b) {
+						continue;
+					}
+
+					for (size_t d = c + 1; d < sameCore.size(); ++d) {
+						if ((vPoints[sameCore[c]] & vPoints[sameCore[d]]) != core) {
+							continue;
+						}
+
+						const std::array<unsigned int, NbrPointsPerLine> line = {{a, b, sameCore[c], sameCore[d]}};
+
+						// Supposed exceptional lines are projective if the matrix associated to the hyperplane of
+						// the next geometry isn't of full rank.
+						const bool isProjective = sameCore.size() == 2 || hasDegenerateMatrix(line, vPoints, nextGeometry);
+
+						if (!coreComputed) {
+							for (const std::bitset<NbrPoints>& geometryLine : m_geometryLines) {
+								if ((core & geometryLine) == geometryLine) {
+									++coreNbrLines;
+								}
+							}
+							coreComputed = true;
+						}
+
+						FlatVeldkampLineTableEntry<NbrPointsPerLine> entry;
+						entry.isProjective = isProjective;
+						entry.coreNbrPoints = static_cast<unsigned int>(core.count());
+						entry.coreNbrLines = coreNbrLines;
+						for (size_t i = 0; i < NbrPointsPerLine; ++i) {
+							entry.pointsType[i] = vPoints_types[line[i]];
+						}
+						entry.sortPointsType();
+
+						const size_t position = entries.add(entry);
+						if constexpr (WithLines) {
+							if (position == entries_lines.size()) {
+								entries_lines.emplace_back();
+							}
+							entries_lines[position].push_back(line);
+						}
+
+						if (isProjective) {
+							table.projectives.push_back(line);
+						}
+					}
+				}
+			}
+		}
+
+		table.entries.reserve(entries.getEntries().size());
+		for (size_t i = 0; i < entries.getEntries().size(); ++i) {
+			const VeldkampLineTableEntry entry = entries.getEntries()[i].toTableEntry(entries.getCounts()[i]);
+			if constexpr (WithLines) {
+				table.entries.emplace_back(entry, entries_lines[i]);
+			} else {
+				table.entries.emplace_back(entry);
+			}
+		}
+
+		return table;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	std::vector<VeldkampLineTableEntry> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeVeldkampLinesTable(
+	  const std::vector<VeldkampLineOrbit<NbrPointsPerLine>>& orbits,
+	  const std::vector<std::bitset<NbrPoints>>& vPoints,
+	  const std::vector<unsigned int>& vPoints_types,
+	  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
+	) const {
+
+		EntriesCounter<FlatVeldkampLineTableEntry<NbrPointsPerLine>> entries;
+		for (const VeldkampLineOrbit<NbrPointsPerLine>& orbit : orbits) {
+			const std::array<unsigned int, NbrPointsPerLine>& line = orbit.representative;
+
+			// Same classification as computeVeldkampLinesTable(), which sees the line from its first two hyperplanes
+			const std::bitset<NbrPoints> core = vPoints[line[0]] & vPoints[line[1]];
+			size_t sameCoreSize = 0;
+			for (const std::bitset<NbrPoints>& hyperplane : vPoints) {
+				if ((vPoints[line[0]] & hyperplane) == core && (vPoints[line[1]] & hyperplane) == core) {
+					++sameCoreSize;
+				}
+			}
+			const bool isProjective = sameCoreSize == 2 || hasDegenerateMatrix(line, vPoints, nextGeometry);
+
+			entries.add(makeLinesTableEntry(isProjective, line, vPoints, vPoints_types), orbit.size);
+		}
+
+		std::vector<VeldkampLineTableEntry> table;
+		table.reserve(entries.getEntries().size());
+		for (size_t i = 0; i < entries.getEntries().size(); ++i) {
+			table.push_back(entries.getEntries()[i].toTableEntry(entries.getCounts()[i]));
+		}
+		return table;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	bool PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::hasDegenerateMatrix(
+	  const std::array<unsigned int, NbrPointsPerLine>& line,
+	  const std::vector<std::bitset<NbrPoints>>& vPoints,
+	  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
+	) const {
+
+		return hasDegenerateMatrix(getHyperplanesOfTheVeldkampLine(vPoints, line), nextGeometry);
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	bool PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::hasDegenerateMatrix(
+	  const std::array<std::bitset<NbrPoints>, NbrPointsPerLine>& hyperplanes,
+	  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry
+	) const {
+
+		constexpr size_t NewNbrPoints = math::pow(NbrPointsPerLine, Dimension + 1);
+
+		const std::bitset<NewNbrPoints> hyperplane = concatenateLayers(hyperplanes);
+		return getRank(nextGeometry.buildMatrix(hyperplane)) < math::pow(2UL, Dimension + 1);
+	}
+
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
 	size_t PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::getRank(
 	  std::vector<std::array<unsigned int, math::pow(2UL, Dimension + 1)>>&& matrix
@@ -419,60 +836,44 @@ namespace segre {
 	  const std::vector<std::array<unsigned int, NbrPointsPerLine>>& pVLines
 	) {
 
-		constexpr size_t NewNbrPoints = math::pow(NbrPointsPerLine, Dimension + 1);
+		return expandLayerTuples(computeLayerTuplesFromVeldkampLines(veldkampPoints, pVLines), veldkampPoints);
+	}
 
-		std::vector<std::bitset<NewNbrPoints>> hyperplanes;
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	std::vector<LayerTuple<NbrPointsPerLine>> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::computeLayerTuplesFromVeldkampLines(
+	  const std::vector<std::bitset<NbrPoints>>& veldkampPoints,
+	  const std::vector<std::array<unsigned int, NbrPointsPerLine>>& pVLines
+	) {
 
-		// Compute the hyperplane of the next geometry using the veldkamp lines of the current geometry.
-		for (size_t i = 0; i < pVLines.size(); ++i) {
-			std::array<std::bitset<NbrPoints>, NbrPointsPerLine> hypers = getHyperplanesOfTheVeldkampLine(veldkampPoints, pVLines[i]);
-			std::sort(hypers.begin(), hypers.end());
+		std::vector<LayerTuple<NbrPointsPerLine>> tuples;
+		tuples.reserve(pVLines.size() * math::facorial<NbrPointsPerLine> + veldkampPoints.size() * NbrPointsPerLine);
 
-			do {
-				std::bitset<NewNbrPoints> hyperplane;
+		const auto hyperplaneLess = [&veldkampPoints](std::uint32_t a, std::uint32_t b) {
+			return bitsetLess(veldkampPoints[a], veldkampPoints[b]);
+		};
 
-				for (size_t j = 0; j < hypers.size(); ++j) {
-					hyperplane |= copyBitset<NewNbrPoints>(hypers[j]) <<= (j * NbrPoints);
-				}
+		// Compute the hyperplane of the next geometry using the veldkamp lines of the current geometry.
+		for (const std::array<unsigned int, NbrPointsPerLine>& line : pVLines) {
+			LayerTuple<NbrPointsPerLine> tuple;
+			std::copy(line.cbegin(), line.cend(), tuple.layers.begin());
+			std::sort(tuple.layers.begin(), tuple.layers.end(), hyperplaneLess);
 
-				hyperplanes.push_back(std::move(hyperplane));
-			} while (std::next_permutation(hypers.begin(), hypers.end()));
+			do {
+				tuples.push_back(tuple);
+			} while (std::next_permutation(tuple.layers.begin(), tuple.layers.end(), hyperplaneLess));
 		}
 
-		std::bitset<NewNbrPoints> fullLayout = copyBitset<NewNbrPoints>(std::bitset<NbrPoints>().flip());
-
-		// Compute the missing hyperplanes by using 3 times the same hyperplane and the current full geometry.
-		for (size_t i = 0; i < veldkampPoints.size(); ++i) {
-			std::bitset<NewNbrPoints> hyperplane = copyBitset<NewNbrPoints>(veldkampPoints[i]);
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) <<= NbrPoints;
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) <<= 2 * NbrPoints;
-			hyperplane |= fullLayout << 3 * NbrPoints;
-
-			hyperplanes.push_back(std::move(hyperplane));
-
-			hyperplane = copyBitset<NewNbrPoints>(veldkampPoints[i]);
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) << NbrPoints;
-			hyperplane |= fullLayout << 2 * NbrPoints;
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) <<= 3 * NbrPoints;
-
-			hyperplanes.push_back(std::move(hyperplane));
-
-			hyperplane = copyBitset<NewNbrPoints>(veldkampPoints[i]);
-			hyperplane |= fullLayout << NbrPoints;
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) << 2 * NbrPoints;
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) <<= 3 * NbrPoints;
-
-			hyperplanes.push_back(std::move(hyperplane));
-
-			hyperplane = fullLayout;
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) <<= NbrPoints;
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) <<= 2 * NbrPoints;
-			hyperplane |= copyBitset<NewNbrPoints>(veldkampPoints[i]) <<= 3 * NbrPoints;
-
-			hyperplanes.push_back(std::move(hyperplane));
+		// Compute the missing hyperplanes by using NbrPointsPerLine - 1 times the same hyperplane and the current full geometry.
+		for (std::uint32_t i = 0; i < veldkampPoints.size(); ++i) {
+			for (size_t full_layer = NbrPointsPerLine; full_layer-- > 0;) {
+				LayerTuple<NbrPointsPerLine> tuple;
+				tuple.layers.fill(i);
+				tuple.layers[full_layer] = LayerTuple<NbrPointsPerLine>::FULL;
+				tuples.push_back(tuple);
+			}
 		}
 
-		return hyperplanes;
+		return tuples;
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
@@ -563,46 +964,40 @@ namespace segre {
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
 	template<bool OrderOfPoints>
-	HyperplaneTableEntry PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::getHyperplaneTableEntry(
+	FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::getHyperplaneTableEntry(
 	  const std::bitset<NbrPoints>& hyperplane
 	) const noexcept {
 
-		HyperplaneTableEntry entry;
+		FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine> entry;
 		entry.nbrPoints = static_cast<unsigned int>(hyperplane.count());
 
-		std::vector<std::bitset<NbrPoints>> includedLines;
+		// Number of included lines going through each point, bit sliced: bit b of the order of point i is
+		// orderPlanes[b][i]. A point is at most on Dimension lines.
+		constexpr size_t NbrOrderPlanes = math::bitWidth(Dimension);
+		std::array<std::bitset<NbrPoints>, NbrOrderPlanes> orderPlanes;
 		for (const std::bitset<NbrPoints>& line : m_geometryLines) {
 			if ((line & hyperplane) == line) {
-				includedLines.push_back(line);
+				++entry.nbrLines;
+
+				if constexpr (OrderOfPoints) {
+					// Add the line to the counters, propagating the carry
+					std::bitset<NbrPoints> carry = line;
+					for (std::bitset<NbrPoints>& plane : orderPlanes) {
+						const std::bitset<NbrPoints> nextCarry = plane & carry;
+						plane ^= carry;
+						carry = nextCarry;
+					}
+				}
 			}
 		}
 
-		entry.nbrLines = static_cast<unsigned int>(includedLines.size());
-
 		if constexpr (OrderOfPoints) {
-			if (entry.nbrLines == 0) {
-				entry.pointsOfOrder[0] = entry.nbrPoints;
-			} else {
-				unsigned int pointOfOrder0 = entry.nbrPoints;
-				for (size_t i = 0; i < NbrPoints; ++i) {
-					unsigned int count = 0;
-					if (hyperplane[i]) {
-						for (size_t j = 0; j < includedLines.size(); ++j) {
-							if (includedLines[j][i] != 0) {
-								++count;
-							}
-						}
-
-						if (count != 0) {
-							++(entry.pointsOfOrder[count]);
-							--pointOfOrder0;
-						}
-					}
-				}
-
-				if (pointOfOrder0 != 0) {
-					entry.pointsOfOrder[0] = pointOfOrder0;
+			for (size_t order = 0; order <= Dimension; ++order) {
+				std::bitset<NbrPoints> pointsOfOrder = hyperplane;
+				for (size_t b = 0; b < NbrOrderPlanes; ++b) {
+					pointsOfOrder &= ((order >> b) & 1U) != 0 ? orderPlanes[b] : ~orderPlanes[b];
 				}
+				entry.pointsOfOrder[order] = static_cast<unsigned int>(pointsOfOrder.count());
 			}
 		}
 
@@ -610,143 +1005,191 @@ namespace segre {
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
-	template<bool OrderOfPoints>
-	HyperplaneTableEntry PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::getHyperplaneTableEntry(
-	  const std::bitset<NbrPoints>& hyperplane, const std::vector<HyperplaneTableEntry>& precedent_table
+	std::bitset<NbrPoints / NbrPointsPerLine> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::extractSubGeometry(
+	  const std::bitset<NbrPoints>& hyperplane,
+	  size_t direction,
+	  size_t slice
 	) const noexcept {
 
-		HyperplaneTableEntry entry;
+		constexpr size_t SubNbrPoints = NbrPoints / NbrPointsPerLine;
 
-		if constexpr (!OrderOfPoints) {
-			entry.nbrPoints = static_cast<unsigned int>(hyperplane.count());
+		std::bitset<SubNbrPoints> subGeometry;
+		const std::array<unsigned int, SubNbrPoints>& points = m_subGeometriesPoints[direction][slice];
+		for (size_t i = 0; i < SubNbrPoints; ++i) {
+			subGeometry[i] = hyperplane[points[i]];
+		}
 
-			std::vector<std::bitset<NbrPoints>> includedLines;
-			for (const std::bitset<NbrPoints>& line : m_geometryLines) {
-				if ((line & hyperplane) == line) {
-					includedLines.push_back(line);
-				}
-			}
+		return subGeometry;
+	}
 
-			entry.nbrLines = static_cast<unsigned int>(includedLines.size());
-		} else {
-			entry = getHyperplaneTableEntry<OrderOfPoints>(hyperplane);
-		}
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	std::array<LayerTuple<NbrPointsPerLine>, Dimension> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::getSubGeometriesIds(
+	  const std::bitset<NbrPoints>& hyperplane,
+	  const HyperplaneIndex<math::pow(NbrPointsPerLine, Dimension - 1)>& precedent_index
+	) const noexcept {
 
-		entry.subgeometries.resize(m_subGeometriesMasks.size());
+		std::array<LayerTuple<NbrPointsPerLine>, Dimension> ids;
 
-		{
-			std::size_t i = 0;
-			for (const auto& direction_masks : m_subGeometriesMasks) {
-				for (const auto& mask : direction_masks) {
-					std::size_t nbr_points = (hyperplane & mask).count();
+		// The slices of the last direction are the layers of the cartesian product (see computeCartesianProduct())
+		const std::array<std::bitset<NbrPoints / NbrPointsPerLine>, NbrPointsPerLine> layers =
+		  splitLayers<NbrPoints / NbrPointsPerLine, NbrPointsPerLine>(hyperplane);
 
-					std::vector<HyperplaneTableEntry>::const_iterator it = std::find_if(
-					  precedent_table.begin(),
-					  precedent_table.end(),
-					  [&nbr_points](const HyperplaneTableEntry& e) {
-					  	return e.nbrPoints == nbr_points;
-					  }
-					);
+		for (size_t direction = 0; direction < Dimension; ++direction) {
+			for (size_t slice = 0; slice < NbrPointsPerLine; ++slice) {
+				const std::bitset<NbrPoints / NbrPointsPerLine> subGeometry = (direction == Dimension - 1)
+				                                                              ? layers[slice]
+				                                                              : extractSubGeometry(hyperplane, direction, slice);
 
-					if (it == precedent_table.cend()) {
-						++(entry.subgeometries[i][-1]);
-					} else {
-						++(entry.subgeometries[i][static_cast<long long int>(std::distance(precedent_table.cbegin(), it))]);
+				if (subGeometry.all()) {
+					ids[direction].layers[slice] = LayerTuple<NbrPointsPerLine>::FULL;
+				} else {
+					const unsigned int id = precedent_index.find(subGeometry);
+					if (id == HyperplaneIndex<math::pow(NbrPointsPerLine, Dimension - 1)>::NOT_FOUND) {
+						IMPOSSIBLE;
 					}
+					ids[direction].layers[slice] = id;
 				}
-
-				++i;
 			}
 		}
 
-		return entry;
+		return ids;
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
 	template<bool OrderOfPoints>
-	std::vector<HyperplaneTableEntry> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeHyperplaneTable(
-	  const std::vector<std::bitset<NbrPoints>>& vPoints
+	FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::getHyperplaneTableEntry(
+	  const std::bitset<NbrPoints>& hyperplane,
+	  const HyperplaneIndex<math::pow(NbrPointsPerLine, Dimension - 1)>& precedent_index,
+	  const std::vector<unsigned int>& precedent_types
 	) const noexcept {
 
-		std::vector<HyperplaneTableEntry> entries;
+		FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine> entry = getHyperplaneTableEntry<OrderOfPoints>(hyperplane);
 
-		for (const auto& vPoint : vPoints) {
-			HyperplaneTableEntry entry = getHyperplaneTableEntry<OrderOfPoints>(vPoint);
+		entry.hasSubgeometries = true;
 
-			std::vector<HyperplaneTableEntry>::iterator it = std::find(entries.begin(), entries.end(), entry);
-			if (it == entries.end()) {
-				entry.count = 1;
-				entries.push_back(entry);
-			} else {
-				++(it->count);
+		const std::array<LayerTuple<NbrPointsPerLine>, Dimension> ids = getSubGeometriesIds(hyperplane, precedent_index);
+		for (size_t direction = 0; direction < Dimension; ++direction) {
+			for (size_t slice = 0; slice < NbrPointsPerLine; ++slice) {
+				const std::uint32_t id = ids[direction].layers[slice];
+				entry.subgeometries[direction][slice] = id == LayerTuple<NbrPointsPerLine>::FULL
+				  ? FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>::FULL
+				  : precedent_types[id];
 			}
 		}
+		entry.sortSubgeometries();
 
-		return entries;
+		return entry;
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
-	template<bool OrderOfPoints>
-	std::vector<HyperplaneTableEntry> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeHyperplaneTable(
+	template<bool OrderOfPoints, ParallelBackend Backend>
+	HyperplanesTable PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeHyperplaneTable(
+	  const std::vector<std::bitset<NbrPoints>>& vPoints
+	) const noexcept {
+
+		std::vector<EntriesCounter<FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>>> partial_tables(getWorkersNumber<Backend>());
+		std::vector<unsigned int> types(vPoints.size());
+		parallelChunks<Backend>(vPoints.size(), [&](size_t chunk, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				types[i] = static_cast<unsigned int>(partial_tables[chunk].add(getHyperplaneTableEntry<OrderOfPoints>(vPoints[i])));
+			}
+		});
+
+		return mergeHyperplaneTables<Backend>(partial_tables, std::move(types));
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	template<bool OrderOfPoints, ParallelBackend Backend>
+	HyperplanesTable PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeHyperplaneTable(
 	  const std::vector<std::bitset<NbrPoints>>& vPoints,
-	  const std::vector<HyperplaneTableEntry>& precedent_table
+	  const HyperplaneIndex<math::pow(NbrPointsPerLine, Dimension - 1)>& precedent_index,
+	  const std::vector<unsigned int>& precedent_types
 	) const noexcept {
 
-		std::vector<HyperplaneTableEntry> entries;
+		std::vector<EntriesCounter<FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>>> partial_tables(getWorkersNumber<Backend>());
+		std::vector<unsigned int> types(vPoints.size());
+		parallelChunks<Backend>(vPoints.size(), [&](size_t chunk, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				types[i] = static_cast<unsigned int>(partial_tables[chunk].add(getHyperplaneTableEntry<OrderOfPoints>(vPoints[i], precedent_index, precedent_types)));
+			}
+		});
 
-		for (const auto& vPoint : vPoints) {
-			HyperplaneTableEntry entry = getHyperplaneTableEntry<OrderOfPoints>(vPoint, precedent_table);
+		return mergeHyperplaneTables<Backend>(partial_tables, std::move(types));
+	}
 
-			// Check if entry already exist
-			std::vector<HyperplaneTableEntry>::iterator it = std::find(entries.begin(), entries.end(), entry);
-			if (it == entries.end()) {
-				entry.count = 1;
-				entries.push_back(entry);
-			} else {
-				++(it->count);
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	template<ParallelBackend Backend>
+	HyperplanesTable PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::mergeHyperplaneTables(
+	  const std::vector<EntriesCounter<FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>>>& partial_tables,
+	  std::vector<unsigned int>&& types
+	) {
+
+		// Position in the merged table of the entries of each partial table
+		EntriesCounter<FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>> entries;
+		std::vector<std::vector<unsigned int>> positions(partial_tables.size());
+		for (size_t chunk = 0; chunk < partial_tables.size(); ++chunk) {
+			const EntriesCounter<FlatHyperplaneTableEntry<Dimension, NbrPointsPerLine>>& partial_table = partial_tables[chunk];
+			positions[chunk].reserve(partial_table.getEntries().size());
+			for (size_t i = 0; i < partial_table.getEntries().size(); ++i) {
+				positions[chunk].push_back(static_cast<unsigned int>(entries.add(partial_table.getEntries()[i], partial_table.getCounts()[i])));
 			}
 		}
 
-		return entries;
+		HyperplanesTable table;
+		table.entries.reserve(entries.getEntries().size());
+		for (size_t i = 0; i < entries.getEntries().size(); ++i) {
+			table.entries.push_back(entries.getEntries()[i].toTableEntry(entries.getCounts()[i]));
+		}
+
+		// Same chunks as the partial tables
+		parallelChunks<Backend>(types.size(), [&](size_t chunk, size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				types[i] = positions[chunk][types[i]];
+			}
+		});
+		table.types = std::move(types);
+
+		return table;
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
-	VeldkampLineTableEntry PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeLinesTableEntry(
+	FlatVeldkampLineTableEntry<NbrPointsPerLine> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeLinesTableEntry(
 	  bool isProjective,
 	  const std::array<unsigned int, NbrPointsPerLine>& line,
 	  const std::vector<std::bitset<NbrPoints>>& vPoints,
-	  const std::vector<HyperplaneTableEntry>& points_table
+	  const std::vector<unsigned int>& vPoints_types
+	) const noexcept {
+
+		std::array<unsigned int, NbrPointsPerLine> types;
+		for (unsigned int i = 0; i < NbrPointsPerLine; ++i) {
+			types[i] = vPoints_types[line[i]];
+		}
+
+		return makeLinesTableEntry(isProjective, vPoints[line[0]] & vPoints[line[1]], types);
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	FlatVeldkampLineTableEntry<NbrPointsPerLine> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeLinesTableEntry(
+	  bool isProjective,
+	  const std::bitset<NbrPoints>& core,
+	  const std::array<unsigned int, NbrPointsPerLine>& types
 	) const noexcept {
 
-		VeldkampLineTableEntry entry;
+		FlatVeldkampLineTableEntry<NbrPointsPerLine> entry;
 		entry.isProjective = isProjective;
 
-		std::bitset<NbrPoints> kernel = vPoints[line[0]] & vPoints[line[1]];
-		entry.coreNbrPoints = kernel.count();
+		entry.coreNbrPoints = static_cast<unsigned int>(core.count());
 		entry.coreNbrLines = 0;
 		for (const std::bitset<NbrPoints>& geometryLine : m_geometryLines) {
-			if ((kernel & geometryLine) == geometryLine) {
+			if ((core & geometryLine) == geometryLine) {
 				++entry.coreNbrLines;
 			}
 		}
 
-
 		for (unsigned int i = 0; i < NbrPointsPerLine; ++i) {
-			const size_t nbr_points = vPoints[line[i]].count();
-			std::vector<HyperplaneTableEntry>::const_iterator it = std::find_if(
-			  points_table.begin(),
-			  points_table.end(),
-              [&nbr_points](const HyperplaneTableEntry& e) {
-			  	return e.nbrPoints == nbr_points;
-              }
-            );
-
-			if (it == points_table.end()) {
-				IMPOSSIBLE;
-			} else {
-				++entry.pointsType[static_cast<long long int>(std::distance(points_table.cbegin(), it))];
-			}
+			entry.pointsType[i] = types[i];
 		}
+		entry.sortPointsType();
 
 		return entry;
 	}
@@ -755,34 +1198,29 @@ namespace segre {
 	std::vector<VeldkampLineTableEntry> PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeVeldkampLinesTable(
 	  VeldkampLines<NbrPointsPerLine>& vLines,
 	  const std::vector<std::bitset<NbrPoints>>& vPoints,
-	  const std::vector<HyperplaneTableEntry>& points_table
+	  const std::vector<unsigned int>& vPoints_types
 	) const noexcept {
 
-		static_assert(Dimension < 4, "Points type determination only work for Dimension < 4");
+		EntriesCounter<FlatVeldkampLineTableEntry<NbrPointsPerLine>> entries;
 
 		const auto makeEntries = [&](
-		  std::vector<VeldkampLineTableEntry>& entries,
-		  const std::vector<std::array<unsigned int, NbrPointsPerLine>> lines,
+		  const std::vector<std::array<unsigned int, NbrPointsPerLine>>& lines,
 		  bool isProjective
 		) {
 			for (const std::array<unsigned int, NbrPointsPerLine>& line : lines) {
-				VeldkampLineTableEntry entry = makeLinesTableEntry(isProjective, line, vPoints, points_table);
-
-				typename std::vector<VeldkampLineTableEntry>::iterator
-				  it = std::find(entries.begin(), entries.end(), entry);
-				if (it == entries.end()) {
-					entry.count = 1;
-					entries.push_back(entry);
-				} else {
-					++(it->count);
-				}
+				entries.add(makeLinesTableEntry(isProjective, line, vPoints, vPoints_types));
 			}
 		};
 
-		std::vector<VeldkampLineTableEntry> entries;
-		makeEntries(entries, vLines.projectives, true);
-		makeEntries(entries, vLines.exceptional, false);
-		return entries;
+		makeEntries(vLines.projectives, true);
+		makeEntries(vLines.exceptional, false);
+
+		std::vector<VeldkampLineTableEntry> table;
+		table.reserve(entries.getEntries().size());
+		for (size_t i = 0; i < entries.getEntries().size(); ++i) {
+			table.push_back(entries.getEntries()[i].toTableEntry(entries.getCounts()[i]));
+		}
+		return table;
 	}
 
 	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
@@ -790,38 +1228,33 @@ namespace segre {
 	  PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>::makeVeldkampLinesTableWithLines(
 	    const VeldkampLines<NbrPointsPerLine>& vLines,
 	    const std::vector<std::bitset<NbrPoints>>& vPoints,
-	    const std::vector<HyperplaneTableEntry>& points_table
+	    const std::vector<unsigned int>& vPoints_types
 	  ) const noexcept {
 
-		static_assert(Dimension < 4, "Points type determination only work for Dimension < 4");
+		EntriesCounter<FlatVeldkampLineTableEntry<NbrPointsPerLine>> flat_entries;
+		std::vector<std::vector<std::array<unsigned int, NbrPointsPerLine>>> entries_lines;
 
 		const auto makeEntries =
-		  [&](std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& entries,
-		      const std::vector<std::array<unsigned int, NbrPointsPerLine>> lines,
+		  [&](const std::vector<std::array<unsigned int, NbrPointsPerLine>>& lines,
 		      bool isProjective) {
 
 			  for (const std::array<unsigned int, NbrPointsPerLine>& line : lines) {
-				  VeldkampLineTableEntry entry = makeLinesTableEntry(isProjective, line, vPoints, points_table);
-
-				  const ptrdiff_t pos = std::find_if(entries.begin(), entries.end(), [&entry](const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& oentry){
-					  return oentry.entry == entry;
-				  }) - entries.begin();
-				  if (pos >= static_cast<ptrdiff_t>(entries.size())) {
-					  entry.count = 1;
-					  VeldkampLineTableEntryWithLines<NbrPointsPerLine> entrywl(entry);
-					  entrywl.lines.push_back(line);
-					  entries.push_back(std::move(entrywl));
-				  } else {
-					  using size_type = typename std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>::size_type;
-					  ++(entries[static_cast<size_type>(pos)].entry.count);
-					  entries[static_cast<size_type>(pos)].lines.push_back(line);
+				  const size_t position = flat_entries.add(makeLinesTableEntry(isProjective, line, vPoints, vPoints_types));
+				  if (position == entries_lines.size()) {
+					  entries_lines.emplace_back();
 				  }
+				  entries_lines[position].push_back(line);
 			  }
 		  };
 
+		makeEntries(vLines.projectives, true);
+		makeEntries(vLines.exceptional, false);
+
 		std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> entries;
-		makeEntries(entries, vLines.projectives, true);
-		makeEntries(entries, vLines.exceptional, false);
+		entries.reserve(flat_entries.getEntries().size());
+		for (size_t i = 0; i < flat_entries.getEntries().size(); ++i) {
+			entries.emplace_back(flat_entries.getEntries()[i].toTableEntry(flat_entries.getCounts()[i]), entries_lines[i]);
+		}
 		return entries;
 	}
 
@@ -903,6 +1336,18 @@ namespace segre {
 				  m_subGeometriesMasks[ignored_line][submask - 1] << gen_lines_indexes[ignored_line][1];
 			}
 		}
+
+		// Points of the masks in increasing order, which is the points order of the previous dimension geometry
+		for (size_t direction = 0; direction < Dimension; ++direction) {
+			for (size_t submask = 0; submask < NbrPointsPerLine; ++submask) {
+				size_t j = 0;
+				for (unsigned int i = 0; i < NbrPoints; ++i) {
+					if (m_subGeometriesMasks[direction][submask][i]) {
+						m_subGeometriesPoints[direction][submask][j++] = i;
+					}
+				}
+			}
+		}
 	}
 }
 
@@ -0,0 +1,103 @@
+#ifndef HYPERPLANEFINDER_POINTPERMUTATION_HPP
+#define HYPERPLANEFINDER_POINTPERMUTATION_HPP
+
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+#include "BitsetWords.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      A permutation of the points of a geometry, compiled to the
+	 *             image of each point: point @c i is sent to point
+	 *             permutation[@c i].
+	 *
+	 * @tparam     NbrPoints  Number of points of the geometry
+	 */
+	template<size_t NbrPoints>
+	using PointPermutation = std::array<std::uint16_t, NbrPoints>;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Apply a compiled permutation to an hyperplane.
+	 *
+	 * @details    Only the points of the hyperplane are visited (lowest set
+	 *             bit of each word), their images are set in the words of the
+	 *             result.
+	 *
+	 * @param[in]  hyperplane   The hyperplane to permute
+	 * @param[in]  permutation  The compiled permutation
+	 *
+	 * @tparam     NbrPoints    Number of points of the geometry
+	 *
+	 * @return     The permuted hyperplane
+	 */
+	template<size_t NbrPoints>
+	std::bitset<NbrPoints> permuteHyperplane(const std::bitset<NbrPoints>& hyperplane, const PointPermutation<NbrPoints>& permutation);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Compose two compiled permutations.
+	 *
+	 * @param[in]  first      The permutation applied first
+	 * @param[in]  second     The permutation applied second
+	 *
+	 * @tparam     NbrPoints  Number of points of the geometry
+	 *
+	 * @return     The permutation applying @p first then @p second
+	 */
+	template<size_t NbrPoints>
+	PointPermutation<NbrPoints> composePermutations(const PointPermutation<NbrPoints>& first, const PointPermutation<NbrPoints>& second);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Get the inverse of a compiled permutation.
+	 *
+	 * @param[in]  permutation  The permutation
+	 *
+	 * @tparam     NbrPoints    Number of points of the geometry
+	 *
+	 * @return     The inverse permutation
+	 */
+	template<size_t NbrPoints>
+	PointPermutation<NbrPoints> invertPermutation(const PointPermutation<NbrPoints>& permutation);
+}
+
+// Implementations
+namespace segre {
+
+	template<size_t NbrPoints>
+	std::bitset<NbrPoints> permuteHyperplane(const std::bitset<NbrPoints>& hyperplane, const PointPermutation<NbrPoints>& permutation) {
+		static_assert(NbrPoints <= 65536, "Points images are stored on 16 bits");
+
+		std::array<std::uint64_t, BITSET_WORDS<NbrPoints>> words{};
+		forEachSetBit(hyperplane, [&words, &permutation](size_t point) {
+			const std::uint16_t image = permutation[point];
+			words[image / 64U] |= std::uint64_t{1} << (image % 64U);
+		});
+		return fromWords<NbrPoints>(words);
+	}
+
+	template<size_t NbrPoints>
+	PointPermutation<NbrPoints> composePermutations(const PointPermutation<NbrPoints>& first, const PointPermutation<NbrPoints>& second) {
+		PointPermutation<NbrPoints> composed;
+		for (size_t i = 0; i < NbrPoints; ++i) {
+			composed[i] = second[first[i]];
+		}
+		return composed;
+	}
+
+	template<size_t NbrPoints>
+	PointPermutation<NbrPoints> invertPermutation(const PointPermutation<NbrPoints>& permutation) {
+		PointPermutation<NbrPoints> inverse;
+		for (size_t i = 0; i < NbrPoints; ++i) {
+			inverse[permutation[i]] = static_cast<std::uint16_t>(i);
+		}
+		return inverse;
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_POINTPERMUTATION_HPP
@@ -0,0 +1,103 @@
+#ifndef HYPERPLANEFINDER_RADIXSORT_HPP
+#define HYPERPLANEFINDER_RADIXSORT_HPP
+
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Stable sort of values by a key of 64 bits words, least
+	 *             significant digit first.
+	 *
+	 * @details    The keys are compared as unsigned integers whose last word is
+	 *             the most significant, which is the order of bitsetLess() for
+	 *             the words of a bitset (see toWords()). A single pass counts
+	 *             the 11 bits digits of all the keys, then each digit not equal
+	 *             for all the keys is a pass distributing the values into a
+	 *             buffer of the size of @p values. The 2048 buckets of a pass
+	 *             keep their counters in the L1 cache and their write positions
+	 *             in the TLB, which wider digits don't. Vectors smaller than
+	 *             RADIX_SORT_MIN_SIZE are sorted with std::stable_sort.
+	 *
+	 * @param      values  The values
+	 * @param[in]  key     Function object returning the key of a value, as a
+	 *                     std::array<std::uint64_t, K>
+	 *
+	 * @tparam     T       Type of the values, default constructible
+	 * @tparam     Key     Type of @p key
+	 */
+	template<typename T, typename Key>
+	void radixSort(std::vector<T>& values, const Key& key);
+
+	constexpr size_t RADIX_SORT_MIN_SIZE = 4096;
+}
+
+// Implementations
+namespace segre {
+
+	template<typename T, typename Key>
+	void radixSort(std::vector<T>& values, const Key& key) {
+		using Words = decltype(key(values.front()));
+		constexpr size_t NbrWords = std::tuple_size<Words>::value;
+		constexpr size_t DigitBits = 11;
+		constexpr size_t DigitsPerWord = (64 + DigitBits - 1) / DigitBits; // The last digit of a word has 9 bits
+		constexpr size_t NbrDigits = NbrWords * DigitsPerWord;
+		constexpr size_t Radix = size_t{1} << DigitBits;
+
+		if(values.size() < RADIX_SORT_MIN_SIZE) {
+			std::stable_sort(values.begin(), values.end(), [&key](const T& a, const T& b) {
+				const Words a_key = key(a);
+				const Words b_key = key(b);
+				for(size_t w = NbrWords; w-- > 0;) {
+					if(a_key[w] != b_key[w]) {
+						return a_key[w] < b_key[w];
+					}
+				}
+				return false;
+			});
+			return;
+		}
+
+		const auto digit = [](const Words& words, size_t d) {
+			return static_cast<size_t>((words[d / DigitsPerWord] >> (DigitBits * (d % DigitsPerWord))) & (Radix - 1));
+		};
+
+		std::vector<size_t> counts(NbrDigits * Radix, 0);
+		for(const T& value : values) {
+			const Words words = key(value);
+			for(size_t d = 0; d < NbrDigits; ++d) {
+				++counts[d * Radix + digit(words, d)];
+			}
+		}
+
+		std::vector<T> buffer(values.size());
+		for(size_t d = 0; d < NbrDigits; ++d) {
+			size_t* const offsets = counts.data() + d * Radix;
+			if(std::find(offsets, offsets + Radix, values.size()) != offsets + Radix) {
+				continue;
+			}
+
+			size_t offset = 0;
+			for(size_t i = 0; i < Radix; ++i) {
+				const size_t count = offsets[i];
+				offsets[i] = offset;
+				offset += count;
+			}
+			for(const T& value : values) {
+				buffer[offsets[digit(key(value), d)]++] = value;
+			}
+			std::swap(values, buffer);
+		}
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_RADIXSORT_HPP
@@ -0,0 +1,279 @@
+#ifndef HYPERPLANEFINDER_RECORDFILE_HPP
+#define HYPERPLANEFINDER_RECORDFILE_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Settings of the computations spilling their data to files.
+	 */
+	struct OutOfCoreOptions {
+
+		OutOfCoreOptions(std::string directory_, size_t memory_budget_)
+		  : directory(std::move(directory_))
+		  , memory_budget(memory_budget_) {
+		}
+
+		std::string directory; ///< Directory of the files of the computation, created if needed
+		size_t memory_budget;  ///< Bytes of data held in memory, for all the workers
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Writer of a record file.
+	 *
+	 * @details    The file is a 32 bytes header (magic, size of a record,
+	 *             records number) followed by the records in native
+	 *             endianness. It is written under a temporary name and renamed
+	 *             on close(), so a record file is either complete or missing.
+	 *
+	 * @tparam     Record  Type of the records, trivially copyable
+	 */
+	template<typename Record>
+	class RecordFileWriter {
+
+		static_assert(std::is_trivially_copyable_v<Record>, "Records are written as bytes");
+
+	public:
+
+		explicit RecordFileWriter(std::string path);
+
+		void add(const Record& record);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Finish the file and give it its name.
+		 *
+		 * @return     False and a message on std::cerr if the file couldn't be
+		 *             written
+		 */
+		bool close();
+
+		std::uint64_t size() const;
+
+	private:
+
+		std::string m_path;
+		std::string m_temporary_path;
+		std::ofstream m_file;
+		std::uint64_t m_nbr_records;
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Buffered sequential reader of a record file (see
+	 *             RecordFileWriter).
+	 *
+	 * @tparam     Record  Type of the records, trivially copyable
+	 */
+	template<typename Record>
+	class RecordFileReader {
+
+		static_assert(std::is_trivially_copyable_v<Record>, "Records are read as bytes");
+
+	public:
+
+		RecordFileReader();
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Open a record file.
+		 *
+		 * @return     False and a message on std::cerr if the file couldn't be
+		 *             read or doesn't hold records of @p Record size
+		 */
+		bool open(const std::string& path);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Read the next record.
+		 *
+		 * @param[out] record  The record
+		 *
+		 * @return     False at the end of the file or if the file couldn't be
+		 *             read, see failed()
+		 */
+		bool next(Record& record);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Check whether reading failed, a message was then written
+		 *             on std::cerr.
+		 */
+		bool failed() const;
+
+		std::uint64_t size() const;
+
+	private:
+
+		static constexpr size_t BUFFER_SIZE = 1U << 14U;
+
+		std::string m_path;
+		std::ifstream m_file;
+		std::uint64_t m_nbr_records;
+		std::uint64_t m_nbr_read;
+		std::vector<Record> m_buffer;
+		size_t m_position;
+		bool m_failed;
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Read the records of a record file.
+	 *
+	 * @param[in]  path      The file path
+	 * @param[in]  function  Function called on each record, in the file order,
+	 *                       as function(record)
+	 *
+	 * @tparam     Record    Type of the records
+	 * @tparam     Function  Type of @p function
+	 *
+	 * @return     False and a message on std::cerr if the file couldn't be read
+	 */
+	template<typename Record, typename Function>
+	bool readRecordFile(const std::string& path, const Function& function);
+}
+
+// Implementations
+namespace segre {
+
+	namespace detail {
+		constexpr size_t RECORD_FILE_HEADER_SIZE = 32;
+		constexpr char RECORD_FILE_MAGIC[8] = {'H', 'F', 'R', 'E', 'C', 'O', 'R', 'D'};
+	}
+
+	template<typename Record>
+	RecordFileWriter<Record>::RecordFileWriter(std::string path)
+	  : m_path(std::move(path))
+	  , m_temporary_path(m_path + ".tmp")
+	  , m_file(m_temporary_path, std::ios::binary | std::ios::trunc)
+	  , m_nbr_records(0) {
+
+		char header[detail::RECORD_FILE_HEADER_SIZE] = {};
+		m_file.write(header, detail::RECORD_FILE_HEADER_SIZE);
+	}
+
+	template<typename Record>
+	void RecordFileWriter<Record>::add(const Record& record) {
+		m_file.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+		++m_nbr_records;
+	}
+
+	template<typename Record>
+	bool RecordFileWriter<Record>::close() {
+		char header[detail::RECORD_FILE_HEADER_SIZE] = {};
+		const std::uint64_t record_size = sizeof(Record);
+		std::memcpy(header, detail::RECORD_FILE_MAGIC, sizeof(detail::RECORD_FILE_MAGIC));
+		std::memcpy(header + 8, &record_size, sizeof(record_size));
+		std::memcpy(header + 16, &m_nbr_records, sizeof(m_nbr_records));
+		m_file.seekp(0);
+		m_file.write(header, detail::RECORD_FILE_HEADER_SIZE);
+		m_file.close();
+		if(!m_file || std::rename(m_temporary_path.c_str(), m_path.c_str()) != 0) {
+			std::cerr << "Failed to write records file " << m_path << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	template<typename Record>
+	std::uint64_t RecordFileWriter<Record>::size() const {
+		return m_nbr_records;
+	}
+
+	template<typename Record>
+	RecordFileReader<Record>::RecordFileReader()
+	  : m_path()
+	  , m_file()
+	  , m_nbr_records(0)
+	  , m_nbr_read(0)
+	  , m_buffer()
+	  , m_position(0)
+	  , m_failed(false) {
+
+	}
+
+	template<typename Record>
+	bool RecordFileReader<Record>::open(const std::string& path) {
+		m_path = path;
+		m_file.open(path, std::ios::binary | std::ios::ate);
+		if(!m_file) {
+			std::cerr << "Failed to open records file " << path << std::endl;
+			m_failed = true;
+			return false;
+		}
+		const size_t file_size = static_cast<size_t>(m_file.tellg());
+		m_file.seekg(0);
+		char header[detail::RECORD_FILE_HEADER_SIZE] = {};
+		std::uint64_t record_size = 0;
+		if(m_file.read(header, detail::RECORD_FILE_HEADER_SIZE)) {
+			std::memcpy(&record_size, header + 8, sizeof(record_size));
+			std::memcpy(&m_nbr_records, header + 16, sizeof(m_nbr_records));
+		}
+		if(!m_file
+		   || std::memcmp(header, detail::RECORD_FILE_MAGIC, sizeof(detail::RECORD_FILE_MAGIC)) != 0
+		   || record_size != sizeof(Record)
+		   || m_nbr_records > (file_size - detail::RECORD_FILE_HEADER_SIZE) / sizeof(Record) // The size below doesn't overflow
+		   || file_size != detail::RECORD_FILE_HEADER_SIZE + m_nbr_records * sizeof(Record)) {
+			std::cerr << "Invalid records file " << path << std::endl;
+			m_failed = true;
+			return false;
+		}
+		m_nbr_read = 0;
+		m_buffer.clear();
+		m_position = 0;
+		m_failed = false;
+		return true;
+	}
+
+	template<typename Record>
+	bool RecordFileReader<Record>::next(Record& record) {
+		if(m_position == m_buffer.size()) {
+			if(m_failed || m_nbr_read == m_nbr_records) {
+				return false;
+			}
+			m_buffer.resize(std::min<std::uint64_t>(BUFFER_SIZE, m_nbr_records - m_nbr_read));
+			if(!m_file.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size() * sizeof(Record)))) {
+				std::cerr << "Failed to read records file " << m_path << std::endl;
+				m_failed = true;
+				return false;
+			}
+			m_nbr_read += m_buffer.size();
+			m_position = 0;
+		}
+		record = m_buffer[m_position++];
+		return true;
+	}
+
+	template<typename Record>
+	bool RecordFileReader<Record>::failed() const {
+		return m_failed;
+	}
+
+	template<typename Record>
+	std::uint64_t RecordFileReader<Record>::size() const {
+		return m_nbr_records;
+	}
+
+	template<typename Record, typename Function>
+	bool readRecordFile(const std::string& path, const Function& function) {
+		RecordFileReader<Record> reader;
+		if(!reader.open(path)) {
+			return false;
+		}
+		Record record{};
+		while(reader.next(record)) {
+			function(record);
+		}
+		return !reader.failed();
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_RECORDFILE_HPP
@@ -0,0 +1,226 @@
+#ifndef HYPERPLANEFINDER_STABILIZERSEARCH_HPP
+#define HYPERPLANEFINDER_STABILIZERSEARCH_HPP
+
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include "PermutationGenerator.hpp"
+#include "math.hpp"
+#include "impossible.hpp"
+
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Stabilizer subgroup of an hyperplane.
+	 *
+	 * @details    The permutations are tuples of [an array with @p Dimension
+	 *             permutations of @p NbrPointsPerLine elements] and [a
+	 *             permutation of @p Dimension elements], see
+	 *             convertPermutation().
+	 *
+	 * @tparam     Dimension         Dimension of the geometry
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine>
+	struct HyperplaneStabilizer {
+		std::vector<std::tuple<std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>, std::array<unsigned int, Dimension>>> generators;
+		size_t order;
+	};
+}
+
+namespace segre::detail {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Backtracking search of the permutations stabilizing an
+	 *             hyperplane.
+	 *
+	 * @details    A permutation is a dimensions permutation sigma and a
+	 *             coordinates permutation pi_i per dimension: coordinate i of a
+	 *             point, c, becomes coordinate sigma(i), pi_i(c). sigma is
+	 *             enumerated first, then the pi_i(k) are assigned by increasing
+	 *             k, all dimensions for each k. A point is checked as soon as
+	 *             all its coordinates are assigned, so branches sending a point
+	 *             of the hyperplane out of it (or the converse) are cut early.
+	 *
+	 *             For the generators, the search follows the identity and,
+	 *             at each variable, looks for one element per other value
+	 *             (coset of the next stabilizer of the chain). Cosets already
+	 *             represented are never searched again, the order is the
+	 *             product of the number of cosets at each variable.
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	class StabilizerSearch {
+
+	public:
+
+		using Permutation = std::tuple<std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension>, std::array<unsigned int, Dimension>>;
+
+		explicit StabilizerSearch(const std::bitset<NbrPoints>& hyperplane)
+		  : m_hyperplane(hyperplane)
+		  , m_points_by_step()
+		  , m_coord_permutations()
+		  , m_used_coords()
+		  , m_dimension_permutation()
+		  , m_dimension_weights() {
+
+			// A point is checkable once its last coordinate is assigned, at step max(c_i * Dimension + i)
+			for(unsigned int point = 0; point < NbrPoints; ++point) {
+				unsigned int remaining = point;
+				size_t step = 0;
+				for(size_t i = 0; i < Dimension; ++i) {
+					step = std::max(step, (remaining % NbrPointsPerLine) * Dimension + i);
+					remaining /= NbrPointsPerLine;
+				}
+				m_points_by_step[step].push_back(point);
+			}
+		}
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Calls @p visit on all the stabilizing permutations.
+		 */
+		template<typename Visitor>
+		void forEachElement(const Visitor& visit) {
+			PermutationGenerator<Dimension> dimension_permutations_generator;
+			while(!dimension_permutations_generator.isFinished()) {
+				setDimensionPermutation(dimension_permutations_generator.nextPermutation());
+				search(0, [&visit](const Permutation& permutation) {
+					visit(permutation);
+					return true;
+				});
+			}
+		}
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Calculates generators and order of the stabilizer.
+		 */
+		HyperplaneStabilizer<Dimension, NbrPointsPerLine> computeStabilizer() {
+			HyperplaneStabilizer<Dimension, NbrPointsPerLine> stabilizer{{}, 1};
+			const auto keepFirst = [&stabilizer](const Permutation& permutation) {
+				stabilizer.generators.push_back(permutation);
+				return false;
+			};
+
+			// First variable: sigma, identity is enumerated first
+			PermutationGenerator<Dimension> dimension_permutations_generator;
+			setDimensionPermutation(dimension_permutations_generator.nextPermutation());
+			size_t dimension_cosets = 1;
+			while(!dimension_permutations_generator.isFinished()) {
+				setDimensionPermutation(dimension_permutations_generator.nextPermutation());
+				if(!search(0, keepFirst)) {
+					++dimension_cosets;
+				}
+			}
+			stabilizer.order *= dimension_cosets;
+
+			// Next variables: the pi_i(k), following the identity
+			std::array<unsigned int, Dimension> identity;
+			for(unsigned int i = 0; i < Dimension; ++i) {
+				identity[i] = i;
+			}
+			setDimensionPermutation(identity);
+			for(size_t step = 0; step < Dimension * NbrPointsPerLine; ++step) {
+				const size_t dimension = step % Dimension;
+				const unsigned int coord = static_cast<unsigned int>(step / Dimension);
+
+				size_t cosets = 1;
+				for(unsigned int value = coord + 1; value < NbrPointsPerLine; ++value) {
+					assign(dimension, coord, value);
+					if(check(step) && !search(step + 1, keepFirst)) {
+						++cosets;
+					}
+					unassign(dimension, coord);
+				}
+				stabilizer.order *= cosets;
+
+				assign(dimension, coord, coord);
+				if(!check(step)) {
+					// The identity is a stabilizing permutation
+					IMPOSSIBLE;
+				}
+			}
+
+			return stabilizer;
+		}
+
+	private:
+
+		static constexpr size_t NBR_STEPS = Dimension * NbrPointsPerLine;
+
+		void setDimensionPermutation(const std::array<unsigned int, Dimension>& dimension_permutation) {
+			m_dimension_permutation = dimension_permutation;
+			for(size_t i = 0; i < Dimension; ++i) {
+				m_dimension_weights[i] = math::pow(static_cast<unsigned int>(NbrPointsPerLine), dimension_permutation[i]);
+			}
+			for(std::array<bool, NbrPointsPerLine>& used : m_used_coords) {
+				used.fill(false);
+			}
+		}
+
+		void assign(size_t dimension, unsigned int coord, unsigned int value) {
+			m_coord_permutations[dimension][coord] = value;
+			m_used_coords[dimension][value] = true;
+		}
+
+		void unassign(size_t dimension, unsigned int coord) {
+			m_used_coords[dimension][m_coord_permutations[dimension][coord]] = false;
+		}
+
+		bool check(size_t step) const {
+			for(unsigned int point : m_points_by_step[step]) {
+				unsigned int remaining = point;
+				unsigned int image = 0;
+				for(size_t i = 0; i < Dimension; ++i) {
+					image += m_coord_permutations[i][remaining % NbrPointsPerLine] * m_dimension_weights[i];
+					remaining /= NbrPointsPerLine;
+				}
+				if(m_hyperplane[point] != m_hyperplane[image]) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Search the stabilizing completions of the variables
+		 *             assigned before @p step.
+		 *
+		 * @return     False if @p visit asked to stop
+		 */
+		template<typename Visitor>
+		bool search(size_t step, const Visitor& visit) {
+			if(step == NBR_STEPS) {
+				return visit(Permutation(m_coord_permutations, m_dimension_permutation));
+			}
+
+			const size_t dimension = step % Dimension;
+			const unsigned int coord = static_cast<unsigned int>(step / Dimension);
+			for(unsigned int value = 0; value < NbrPointsPerLine; ++value) {
+				if(m_used_coords[dimension][value]) {
+					continue;
+				}
+				assign(dimension, coord, value);
+				const bool carry_on = !check(step) || search(step + 1, visit);
+				unassign(dimension, coord);
+				if(!carry_on) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		const std::bitset<NbrPoints> m_hyperplane;
+		std::array<std::vector<unsigned int>, NBR_STEPS> m_points_by_step;
+		std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension> m_coord_permutations;
+		std::array<std::array<bool, NbrPointsPerLine>, Dimension> m_used_coords;
+		std::array<unsigned int, Dimension> m_dimension_permutation;
+		std::array<unsigned int, Dimension> m_dimension_weights;
+	};
+}
+
+
+#endif //HYPERPLANEFINDER_STABILIZERSEARCH_HPP
@@ -0,0 +1,305 @@
+#ifndef HYPERPLANEFINDER_SYMMETRYGROUP_HPP
+#define HYPERPLANEFINDER_SYMMETRYGROUP_HPP
+
+
+#include <algorithm>
+#include <bitset>
+#include <limits>
+#include <vector>
+
+#include "HyperplaneIndex.hpp"
+#include "HyperplanesUtility.hpp"
+#include "ParallelFor.hpp"
+#include "PointPermutation.hpp"
+#include "math.hpp"
+#include "impossible.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Orbits of hyperplanes under a SymmetryGroup, with the
+	 *             Schreier tree of each orbit.
+	 *
+	 * @details    The orbits are numbered in the order of their smallest
+	 *             hyperplane id, which is their representative. Each
+	 *             hyperplane @c h other than a representative is reached from
+	 *             parents[@c h] by generator parentGenerators[@c h].
+	 */
+	struct HyperplaneOrbits {
+		static constexpr unsigned int NO_PARENT = std::numeric_limits<unsigned int>::max();
+
+		HyperplaneOrbits()
+		  : orbits{}
+		  , representatives{}
+		  , sizes{}
+		  , parents{}
+		  , parentGenerators{} {
+		}
+
+		std::vector<unsigned int> orbits; ///< Orbit of each hyperplane
+		std::vector<unsigned int> representatives; ///< Representative of each orbit
+		std::vector<unsigned int> sizes; ///< Size of each orbit
+		std::vector<unsigned int> parents; ///< Parent of each hyperplane in its Schreier tree
+		std::vector<unsigned int> parentGenerators; ///< Generator sending the parent to the hyperplane
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Symmetry group of a geometry: permutations of the
+	 *             coordinates of each dimension and permutations of the
+	 *             dimensions.
+	 *
+	 * @details    The group is held by a generating set: the adjacent
+	 *             transpositions of the coordinates of each dimension then the
+	 *             adjacent transpositions of the dimensions. Orbits,
+	 *             transversals and stabilizers are computed from the actions of
+	 *             these generators only, never enumerating the group.
+	 *
+	 * @tparam     Dimension         Dimension of the geometry
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 * @tparam     NbrPoints         Number of points of the geometry
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	class SymmetryGroup {
+
+	public:
+
+		SymmetryGroup();
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Get the order of the group, (@p NbrPointsPerLine!)^@p
+		 *             Dimension * @p Dimension!.
+		 */
+		static constexpr size_t getOrder();
+
+		const std::vector<PointPermutation<NbrPoints>>& getGenerators() const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Calculates the action of each generator on the
+		 *             hyperplanes.
+		 *
+		 * @details    Element (@c g, @c h) is the id of the hyperplane obtained
+		 *             by applying generator @c g to hyperplane @c h. The
+		 *             hyperplanes must be closed under the group.
+		 *
+		 * @param[in]  hyperplanes  The hyperplanes
+		 * @param[in]  index        The index of @p hyperplanes
+		 *
+		 * @tparam     Backend      The parallel backend
+		 *
+		 * @return     The generators actions
+		 */
+		template<ParallelBackend Backend = ParallelBackend::Sequential>
+		std::vector<std::vector<unsigned int>> computeGeneratorsActions(const std::vector<std::bitset<NbrPoints>>& hyperplanes, const HyperplaneIndex<NbrPoints>& index) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Calculates the orbits of the hyperplanes by breadth first
+		 *             search over the generators actions.
+		 *
+		 * @param[in]  generators_actions  The generators actions, from
+		 *                                 computeGeneratorsActions()
+		 *
+		 * @return     The orbits and their Schreier trees
+		 */
+		HyperplaneOrbits computeOrbits(const std::vector<std::vector<unsigned int>>& generators_actions) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Get a group element sending the representative of the
+		 *             orbit of @p hyperplane to @p hyperplane.
+		 *
+		 * @param[in]  orbits      The orbits
+		 * @param[in]  hyperplane  The hyperplane id
+		 *
+		 * @return     The transversal element
+		 */
+		PointPermutation<NbrPoints> getTransversal(const HyperplaneOrbits& orbits, unsigned int hyperplane) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Calculates generators of the stabilizer of the
+		 *             representative of an orbit.
+		 *
+		 * @details    Schreier generators t(s(h))^-1 s t(h) for each hyperplane
+		 *             @c h of the orbit and each generator @c s, without
+		 *             duplicates nor identity. The stabilizer order is
+		 *             getOrder() / orbit size.
+		 *
+		 * @param[in]  orbits              The orbits
+		 * @param[in]  generators_actions  The generators actions
+		 * @param[in]  orbit               The orbit number
+		 *
+		 * @return     Generators of the stabilizer
+		 */
+		std::vector<PointPermutation<NbrPoints>> computeStabilizerGenerators(const HyperplaneOrbits& orbits, const std::vector<std::vector<unsigned int>>& generators_actions, unsigned int orbit) const;
+
+	private:
+
+		std::vector<PointPermutation<NbrPoints>> m_generators;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	SymmetryGroup<Dimension, NbrPointsPerLine, NbrPoints>::SymmetryGroup()
+	  : m_generators() {
+
+		std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension> coord_identities;
+		for(std::array<unsigned int, NbrPointsPerLine>& identity : coord_identities) {
+			for(unsigned int i = 0; i < NbrPointsPerLine; ++i) {
+				identity[i] = i;
+			}
+		}
+		std::array<unsigned int, Dimension> dimension_identity;
+		for(unsigned int i = 0; i < Dimension; ++i) {
+			dimension_identity[i] = i;
+		}
+
+		for(size_t dimension = 0; dimension < Dimension; ++dimension) {
+			for(size_t coord = 0; coord + 1 < NbrPointsPerLine; ++coord) {
+				std::array<std::array<unsigned int, NbrPointsPerLine>, Dimension> coord_permutations = coord_identities;
+				std::swap(coord_permutations[dimension][coord], coord_permutations[dimension][coord + 1]);
+				m_generators.push_back(compilePermutation<Dimension, NbrPointsPerLine>(coord_permutations, dimension_identity));
+			}
+		}
+		for(size_t dimension = 0; dimension + 1 < Dimension; ++dimension) {
+			std::array<unsigned int, Dimension> dimension_permutation = dimension_identity;
+			std::swap(dimension_permutation[dimension], dimension_permutation[dimension + 1]);
+			m_generators.push_back(compilePermutation<Dimension, NbrPointsPerLine>(coord_identities, dimension_permutation));
+		}
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	constexpr size_t SymmetryGroup<Dimension, NbrPointsPerLine, NbrPoints>::getOrder() {
+		return math::pow(static_cast<size_t>(math::facorial<NbrPointsPerLine>), Dimension) * math::facorial<Dimension>;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	const std::vector<PointPermutation<NbrPoints>>& SymmetryGroup<Dimension, NbrPointsPerLine, NbrPoints>::getGenerators() const {
+		return m_generators;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	template<ParallelBackend Backend>
+	std::vector<std::vector<unsigned int>> SymmetryGroup<Dimension, NbrPointsPerLine, NbrPoints>::computeGeneratorsActions(const std::vector<std::bitset<NbrPoints>>& hyperplanes, const HyperplaneIndex<NbrPoints>& index) const {
+		std::vector<std::vector<unsigned int>> generators_actions(m_generators.size(), std::vector<unsigned int>(hyperplanes.size()));
+
+		parallelChunks<Backend>(hyperplanes.size(), [&](size_t, size_t begin, size_t end) {
+			for(size_t g = 0; g < m_generators.size(); ++g) {
+				for(size_t h = begin; h < end; ++h) {
+					const unsigned int pos = index.find(permuteHyperplane(hyperplanes[h], m_generators[g]));
+					if(pos == HyperplaneIndex<NbrPoints>::NOT_FOUND) {
+						IMPOSSIBLE;
+					}
+					generators_actions[g][h] = pos;
+				}
+			}
+		});
+
+		return generators_actions;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	HyperplaneOrbits SymmetryGroup<Dimension, NbrPointsPerLine, NbrPoints>::computeOrbits(const std::vector<std::vector<unsigned int>>& generators_actions) const {
+		const size_t nbr_hyperplanes = generators_actions.empty() ? 0 : generators_actions[0].size();
+
+		HyperplaneOrbits orbits;
+		orbits.orbits.assign(nbr_hyperplanes, HyperplaneOrbits::NO_PARENT);
+		orbits.parents.assign(nbr_hyperplanes, HyperplaneOrbits::NO_PARENT);
+		orbits.parentGenerators.assign(nbr_hyperplanes, HyperplaneOrbits::NO_PARENT);
+
+		std::vector<unsigned int> queue;
+		queue.reserve(nbr_hyperplanes);
+		for(unsigned int representative = 0; representative < nbr_hyperplanes; ++representative) {
+			if(orbits.orbits[representative] != HyperplaneOrbits::NO_PARENT) {
+				continue;
+			}
+
+			const unsigned int orbit = static_cast<unsigned int>(orbits.representatives.size());
+			orbits.representatives.push_back(representative);
+			orbits.orbits[representative] = orbit;
+
+			queue.clear();
+			queue.push_back(representative);
+			for(size_t next = 0; next < queue.size(); ++next) {
+				const unsigned int hyperplane = queue[next];
+				for(unsigned int g = 0; g < generators_actions.size(); ++g) {
+					const unsigned int image = generators_actions[g][hyperplane];
+					if(orbits.orbits[image] == HyperplaneOrbits::NO_PARENT) {
+						orbits.orbits[image] = orbit;
+						orbits.parents[image] = hyperplane;
+						orbits.parentGenerators[image] = g;
+						queue.push_back(image);
+					}
+				}
+			}
+			orbits.sizes.push_back(static_cast<unsigned int>(queue.size()));
+		}
+
+		return orbits;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	PointPermutation<NbrPoints> SymmetryGroup<Dimension, NbrPointsPerLine, NbrPoints>::getTransversal(const HyperplaneOrbits& orbits, unsigned int hyperplane) const {
+		std::vector<unsigned int> path;
+		for(unsigned int current = hyperplane; orbits.parents[current] != HyperplaneOrbits::NO_PARENT; current = orbits.parents[current]) {
+			path.push_back(orbits.parentGenerators[current]);
+		}
+
+		PointPermutation<NbrPoints> transversal;
+		for(unsigned int i = 0; i < NbrPoints; ++i) {
+			transversal[i] = static_cast<std::uint16_t>(i);
+		}
+		for(auto it = path.crbegin(); it != path.crend(); ++it) {
+			transversal = composePermutations(transversal, m_generators[*it]);
+		}
+		return transversal;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	std::vector<PointPermutation<NbrPoints>> SymmetryGroup<Dimension, NbrPointsPerLine, NbrPoints>::computeStabilizerGenerators(const HyperplaneOrbits& orbits, const std::vector<std::vector<unsigned int>>& generators_actions, unsigned int orbit) const {
+		std::vector<unsigned int> orbit_hyperplanes;
+		orbit_hyperplanes.reserve(orbits.sizes[orbit]);
+		for(unsigned int h = 0; h < orbits.orbits.size(); ++h) {
+			if(orbits.orbits[h] == orbit) {
+				orbit_hyperplanes.push_back(h);
+			}
+		}
+
+		// Transversal elements and their inverses, indexed by position in the orbit
+		std::vector<PointPermutation<NbrPoints>> transversals;
+		std::vector<PointPermutation<NbrPoints>> inverse_transversals;
+		transversals.reserve(orbit_hyperplanes.size());
+		inverse_transversals.reserve(orbit_hyperplanes.size());
+		for(unsigned int h : orbit_hyperplanes) {
+			transversals.push_back(getTransversal(orbits, h));
+			inverse_transversals.push_back(invertPermutation(transversals.back()));
+		}
+		const auto positionInOrbit = [&orbit_hyperplanes](unsigned int h) {
+			return static_cast<size_t>(std::lower_bound(orbit_hyperplanes.cbegin(), orbit_hyperplanes.cend(), h) - orbit_hyperplanes.cbegin());
+		};
+
+		PointPermutation<NbrPoints> identity;
+		for(unsigned int i = 0; i < NbrPoints; ++i) {
+			identity[i] = static_cast<std::uint16_t>(i);
+		}
+
+		std::vector<PointPermutation<NbrPoints>> stabilizer_generators;
+		for(size_t i = 0; i < orbit_hyperplanes.size(); ++i) {
+			for(size_t g = 0; g < m_generators.size(); ++g) {
+				const size_t image = positionInOrbit(generators_actions[g][orbit_hyperplanes[i]]);
+				const PointPermutation<NbrPoints> schreier_generator = composePermutations(composePermutations(transversals[i], m_generators[g]), inverse_transversals[image]);
+				if(schreier_generator != identity) {
+					stabilizer_generators.push_back(schreier_generator);
+				}
+			}
+		}
+		std::sort(stabilizer_generators.begin(), stabilizer_generators.end());
+		stabilizer_generators.erase(std::unique(stabilizer_generators.begin(), stabilizer_generators.end()), stabilizer_generators.end());
+
+		return stabilizer_generators;
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_SYMMETRYGROUP_HPP
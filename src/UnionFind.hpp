@@ -0,0 +1,87 @@
+#ifndef HYPERPLANEFINDER_UNIONFIND_HPP
+#define HYPERPLANEFINDER_UNIONFIND_HPP
+
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Disjoint sets of the integers [0, size).
+	 *
+	 * @details    The representative of a set is always its smallest element,
+	 *             so iterating on the elements and keeping the ones that are
+	 *             their own representative lists the sets in the order of their
+	 *             first element. Paths are halved on lookup.
+	 */
+	class UnionFind {
+
+	public:
+
+		explicit UnionFind(size_t size);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Find the representative of the set of an element.
+		 *
+		 * @param[in]  element  The element
+		 *
+		 * @return     The smallest element of the set of @p element
+		 */
+		unsigned int find(unsigned int element);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Merge the sets of two elements.
+		 *
+		 * @return     True if the elements were in different sets
+		 */
+		bool unite(unsigned int first, unsigned int second);
+
+		size_t size() const;
+
+	private:
+
+		std::vector<unsigned int> m_parents;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	inline UnionFind::UnionFind(size_t size)
+	  : m_parents(size) {
+
+		std::iota(m_parents.begin(), m_parents.end(), 0U);
+	}
+
+	inline unsigned int UnionFind::find(unsigned int element) {
+		while(m_parents[element] != element) {
+			m_parents[element] = m_parents[m_parents[element]];
+			element = m_parents[element];
+		}
+		return element;
+	}
+
+	inline bool UnionFind::unite(unsigned int first, unsigned int second) {
+		first = find(first);
+		second = find(second);
+		if(first == second) {
+			return false;
+		}
+		if(second < first) {
+			std::swap(first, second);
+		}
+		m_parents[second] = first;
+		return true;
+	}
+
+	inline size_t UnionFind::size() const {
+		return m_parents.size();
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_UNIONFIND_HPP
@@ -0,0 +1,231 @@
+#ifndef HYPERPLANEFINDER_VELDKAMPLINERUNS_HPP
+#define HYPERPLANEFINDER_VELDKAMPLINERUNS_HPP
+
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <experimental/filesystem>
+
+#include "RecordFile.hpp"
+#include "impossible.hpp"
+
+// Declarations
+namespace segre {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      A veldkamp line stored in a run file, with the fields of its
+	 *             lines table entry (see FlatVeldkampLineTableEntry).
+	 *
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 */
+	template<size_t NbrPointsPerLine>
+	struct VeldkampLineRecord {
+		std::array<std::uint32_t, NbrPointsPerLine> line;       ///< Increasing ids of the hyperplanes of the line
+		std::array<std::uint32_t, NbrPointsPerLine> pointsType; ///< Sorted types of the hyperplanes of the line
+		std::uint32_t isProjective;
+		std::uint32_t coreNbrPoints;
+		std::uint32_t coreNbrLines;
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Writer of a run file: veldkamp lines records sorted by line,
+	 *             read back with readRecordFile().
+	 */
+	template<size_t NbrPointsPerLine>
+	using VeldkampLineRunWriter = RecordFileWriter<VeldkampLineRecord<NbrPointsPerLine>>;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      A lines table entry (see FlatVeldkampLineTableEntry) stored
+	 *             in a run file with its weight.
+	 *
+	 * @tparam     NbrPointsPerLine  Number of points per lines of the geometry
+	 */
+	template<size_t NbrPointsPerLine>
+	struct VeldkampLineEntryRecord {
+		std::uint64_t weight;
+		std::array<std::uint32_t, NbrPointsPerLine> pointsType; ///< Sorted types of the hyperplanes of the lines
+		std::uint32_t isProjective;
+		std::uint32_t coreNbrPoints;
+		std::uint32_t coreNbrLines;
+	};
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Completed blocks of an out of core veldkamp lines
+	 *             computation.
+	 *
+	 * @details    The file is a 32 bytes header (magic, hyperplanes number,
+	 *             blocks number) followed by a (block, runs number) record per
+	 *             completed block, appended once all the runs of the block are
+	 *             written. A record cut by an interruption is dropped on
+	 *             restore().
+	 */
+	class VeldkampLinesCheckpoint {
+
+	public:
+
+		explicit VeldkampLinesCheckpoint(std::string path);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Read the checkpoint file, or create it if it doesn't
+		 *             exist.
+		 *
+		 * @param[in]  nbr_hyperplanes  The number of hyperplanes of the
+		 *                              computation
+		 * @param[in]  nbr_blocks       The number of blocks of the computation
+		 *
+		 * @return     False and a message on std::cerr if the file couldn't be
+		 *             read or written, or belongs to another computation
+		 */
+		bool restore(std::uint64_t nbr_hyperplanes, std::uint64_t nbr_blocks);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Record a completed block, thread safe.
+		 *
+		 * @return     False and a message on std::cerr if the record couldn't be
+		 *             written
+		 */
+		bool complete(size_t block, size_t nbr_runs);
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Check if a block is completed, not thread safe: not to be
+		 *             called while blocks are completed.
+		 */
+		bool isCompleted(size_t block) const;
+
+		/*------------------------------------------------------------------------*//**
+		 * @brief      Get the runs number of a completed block, not thread safe:
+		 *             not to be called while blocks are completed.
+		 */
+		size_t getRunsNumber(size_t block) const;
+
+	private:
+
+		static constexpr size_t HEADER_SIZE = 32;
+		static constexpr size_t RECORD_SIZE = 16;
+		static constexpr char MAGIC[8] = {'H', 'F', 'L', 'N', 'C', 'K', 'P', 'T'};
+		static constexpr std::uint64_t NOT_COMPLETED = std::numeric_limits<std::uint64_t>::max();
+
+		std::string m_path;
+		std::vector<std::uint64_t> m_runs_numbers; ///< NOT_COMPLETED for the blocks not completed, sized by restore()
+		std::ofstream m_file;
+		std::mutex m_mutex;
+	};
+}
+
+// Implementations
+namespace segre {
+
+	inline VeldkampLinesCheckpoint::VeldkampLinesCheckpoint(std::string path)
+	  : m_path(std::move(path))
+	  , m_runs_numbers()
+	  , m_file()
+	  , m_mutex() {
+
+	}
+
+	inline bool VeldkampLinesCheckpoint::restore(std::uint64_t nbr_hyperplanes, std::uint64_t nbr_blocks) {
+		namespace fs = std::experimental::filesystem;
+
+		// Sized once: complete() never reallocates the records of the other blocks
+		m_runs_numbers.assign(nbr_blocks, NOT_COMPLETED);
+		std::ifstream input(m_path, std::ios::binary | std::ios::ate);
+		if(!input) {
+			char header[HEADER_SIZE] = {};
+			std::memcpy(header, MAGIC, sizeof(MAGIC));
+			std::memcpy(header + 8, &nbr_hyperplanes, sizeof(nbr_hyperplanes));
+			std::memcpy(header + 16, &nbr_blocks, sizeof(nbr_blocks));
+			std::ofstream output(m_path, std::ios::binary | std::ios::trunc);
+			output.write(header, HEADER_SIZE);
+			if(!output) {
+				std::cerr << "Failed to write veldkamp lines checkpoint " << m_path << std::endl;
+				return false;
+			}
+		}
+		else {
+			const size_t file_size = static_cast<size_t>(input.tellg());
+			input.seekg(0);
+			char header[HEADER_SIZE] = {};
+			std::uint64_t checkpoint_nbr_hyperplanes = 0;
+			std::uint64_t checkpoint_nbr_blocks = 0;
+			if(input.read(header, HEADER_SIZE)) {
+				std::memcpy(&checkpoint_nbr_hyperplanes, header + 8, sizeof(checkpoint_nbr_hyperplanes));
+				std::memcpy(&checkpoint_nbr_blocks, header + 16, sizeof(checkpoint_nbr_blocks));
+			}
+			if(!input
+			   || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0
+			   || checkpoint_nbr_hyperplanes != nbr_hyperplanes
+			   || checkpoint_nbr_blocks != nbr_blocks) {
+				std::cerr << "Invalid veldkamp lines checkpoint " << m_path << std::endl;
+				return false;
+			}
+
+			const size_t nbr_records = (file_size - HEADER_SIZE) / RECORD_SIZE;
+			for(size_t i = 0; i < nbr_records; ++i) {
+				std::uint64_t record[2];
+				if(!input.read(reinterpret_cast<char*>(record), RECORD_SIZE)) {
+					std::cerr << "Failed to read veldkamp lines checkpoint " << m_path << std::endl;
+					return false;
+				}
+				if(record[0] >= nbr_blocks) {
+					std::cerr << "Invalid veldkamp lines checkpoint " << m_path << std::endl;
+					return false;
+				}
+				m_runs_numbers[record[0]] = record[1];
+			}
+			input.close();
+
+			// Drop a record cut by an interruption, the next ones are appended after the complete ones
+			std::error_code error;
+			fs::resize_file(m_path, HEADER_SIZE + nbr_records * RECORD_SIZE, error);
+			if(error) {
+				std::cerr << "Failed to write veldkamp lines checkpoint " << m_path << std::endl;
+				return false;
+			}
+		}
+
+		m_file.open(m_path, std::ios::binary | std::ios::app);
+		if(!m_file) {
+			std::cerr << "Failed to write veldkamp lines checkpoint " << m_path << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	inline bool VeldkampLinesCheckpoint::complete(size_t block, size_t nbr_runs) {
+		if(block >= m_runs_numbers.size()) {
+			IMPOSSIBLE;
+		}
+		const std::uint64_t record[2] = {block, nbr_runs};
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_file.write(reinterpret_cast<const char*>(record), RECORD_SIZE);
+		m_file.flush();
+		if(!m_file) {
+			std::cerr << "Failed to write veldkamp lines checkpoint " << m_path << std::endl;
+			return false;
+		}
+		m_runs_numbers[block] = nbr_runs;
+		return true;
+	}
+
+	inline bool VeldkampLinesCheckpoint::isCompleted(size_t block) const {
+		return m_runs_numbers[block] != NOT_COMPLETED;
+	}
+
+	inline size_t VeldkampLinesCheckpoint::getRunsNumber(size_t block) const {
+		return m_runs_numbers[block];
+	}
+}
+
+
+#endif //HYPERPLANEFINDER_VELDKAMPLINERUNS_HPP
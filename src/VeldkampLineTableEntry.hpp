@@ -2,13 +2,17 @@
 #define HYPERPLANEFINDER_VELDKAMPLINETABLEENTRY_HPP
 
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <vector>
 #include <map>
 
 #include "math.hpp"
+#include "FlatHashMap.hpp"
 
 namespace segre {
 
@@ -38,6 +42,68 @@ namespace segre {
 		size_t count;
 	};
 
+	/**
+	 * Fixed size form of a VeldkampLineTableEntry (without its count), computed for every line without any
+	 * allocation and used as the key to aggregate the entries.
+	 * The types of the points of the line are kept sorted (see sortPointsType()).
+	 */
+	template<size_t NbrPointsPerLine>
+	struct FlatVeldkampLineTableEntry {
+
+		FlatVeldkampLineTableEntry()
+		  : isProjective(false)
+		  , coreNbrPoints(0)
+		  , coreNbrLines(0)
+		  , pointsType() {
+		}
+
+		/**
+		 * Puts the points types in their canonical order.
+		 */
+		void sortPointsType() {
+			std::sort(pointsType.begin(), pointsType.end());
+		}
+
+		/**
+		 * Converts back the entry to the table entry used by the printers.
+		 *
+		 * @param count the number of lines of the entry.
+		 * @return the table entry.
+		 */
+		VeldkampLineTableEntry toTableEntry(size_t count) const {
+			VeldkampLineTableEntry entry;
+			entry.isProjective = isProjective;
+			entry.coreNbrPoints = coreNbrPoints;
+			entry.coreNbrLines = coreNbrLines;
+			for (std::uint32_t type : pointsType) {
+				++(entry.pointsType[static_cast<long long int>(type)]);
+			}
+			entry.count = count;
+			return entry;
+		}
+
+		bool operator==(const FlatVeldkampLineTableEntry& entry) const {
+			return isProjective == entry.isProjective
+			       && coreNbrPoints == entry.coreNbrPoints
+			       && coreNbrLines == entry.coreNbrLines
+			       && pointsType == entry.pointsType;
+		}
+
+		std::uint64_t hash() const {
+			std::uint64_t hash = hashCombine(isProjective ? 1 : 0, coreNbrPoints);
+			hash = hashCombine(hash, coreNbrLines);
+			for (std::uint32_t type : pointsType) {
+				hash = hashCombine(hash, type);
+			}
+			return hash;
+		}
+
+		bool isProjective;
+		unsigned int coreNbrPoints;
+		unsigned int coreNbrLines;
+		std::array<std::uint32_t, NbrPointsPerLine> pointsType;
+	};
+
 	template<size_t NbrPointsPerLine>
 	struct VeldkampLineTableEntryWithLines {
 
@@ -60,6 +126,35 @@ namespace segre {
 		std::vector<std::array<unsigned int, NbrPointsPerLine>> lines;
 	};
 
+	/**
+	 * Veldkamp lines table of a geometry, with the projective lines needed to build the hyperplanes of the next
+	 * geometry.
+	 */
+	template<size_t NbrPointsPerLine>
+	struct VeldkampLinesTable {
+
+		VeldkampLinesTable()
+		  : entries()
+		  , projectives() {
+		}
+
+		/**
+		 * Returns the entries of the table without their lines.
+		 * @return the entries of the table.
+		 */
+		std::vector<VeldkampLineTableEntry> getEntries() const {
+			std::vector<VeldkampLineTableEntry> table;
+			table.reserve(entries.size());
+			for (const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& entry : entries) {
+				table.push_back(entry.entry);
+			}
+			return table;
+		}
+
+		std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> entries;
+		std::vector<std::array<unsigned int, NbrPointsPerLine>> projectives;
+	};
+
 	inline std::ostream& operator<<(std::ostream& os, const VeldkampLineTableEntry& entry) {
 		os << "VeldkampLineEntry{"
 		   << "Proj: " << std::boolalpha << entry.isProjective
@@ -82,5 +177,14 @@ namespace segre {
 	}
 }
 
+namespace std {
+	template <size_t NbrPointsPerLine>
+	struct hash<segre::FlatVeldkampLineTableEntry<NbrPointsPerLine>> {
+		size_t operator()(const segre::FlatVeldkampLineTableEntry<NbrPointsPerLine>& entry) const noexcept {
+			return static_cast<size_t>(entry.hash());
+		}
+	};
+}
+
 
 #endif //HYPERPLANEFINDER_VELDKAMPLINETABLEENTRY_HPP
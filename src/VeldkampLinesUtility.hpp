@@ -2,10 +2,27 @@
 #define HYPERPLANEFINDER_VELDKAMPLINESUTILITY_HPP
 
 
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <system_error>
 #include <vector>
 
+#include <experimental/filesystem>
+
 #include "PointGeometry.hpp"
+#include "CanonicalForm.hpp"
+#include "FlatHashMap.hpp"
 #include "HyperplanesUtility.hpp"
+#include "LinearForms.hpp"
+#include "ParallelFor.hpp"
+#include "PermutationTable.hpp"
+#include "RecordFile.hpp"
+#include "SymmetryGroup.hpp"
+#include "UnionFind.hpp"
+#include "VeldkampLineRuns.hpp"
 
 // Declarations
 namespace segre {
@@ -24,13 +41,14 @@ namespace segre {
 	 * @tparam     NbrPointsPerLine        Number of points per lines of the
 	 *                                     geometry
 	 * @tparam     NbrPoints               Number of points of the geometry
+	 * @tparam     Id                      Type of the hyperplanes ids
 	 *
 	 * @return     The permuted Veldkamp line.
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension), typename Id>
 	std::array<unsigned int, NbrPointsPerLine> applyPermutation(
 	  const std::array<unsigned int, NbrPointsPerLine>& line,
-	  const std::vector<std::vector<unsigned int>>& hyp_permutations_table,
+	  const PermutationTable<Id>& hyp_permutations_table,
 	  size_t permutation_number
 	);
 
@@ -50,6 +68,9 @@ namespace segre {
 	 *
 	 *             4. Return the subentries
 	 *
+	 *             Permuted lines are found through an hash map of the sorted
+	 *             lines of the entry.
+	 *
 	 * @param[in]  lines_table_entry       The Veldkamp lines table entry (with
 	 *                                     lines)
 	 * @param[in]  hyp_permutations_table  The hyperplanes permutations table
@@ -59,13 +80,14 @@ namespace segre {
 	 * @tparam     NbrPointsPerLine        Number of points per lines of the
 	 *                                     geometry
 	 * @tparam     NbrPoints               Number of points of the geometry
+	 * @tparam     Id                      Type of the hyperplanes ids
 	 *
 	 * @return     The Veldkamp lines table entries resulting of the separation
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension), typename Id>
 	std::vector<VeldkampLineTableEntry> separateByPermutations(
 	  const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry,
-	  const std::vector<std::vector<unsigned int>>& hyp_permutations_table,
+	  const PermutationTable<Id>& hyp_permutations_table,
 	  unsigned int permutations_number
 	);
 
@@ -85,14 +107,15 @@ namespace segre {
 	 * @tparam     NbrPointsPerLine        Number of points per lines of the
 	 *                                     geometry
 	 * @tparam     NbrPoints               Number of points of the geometry
+	 * @tparam     Id                      Type of the hyperplanes ids
 	 *
 	 * @return     The Veldkamp lines table entries (with lines) resulting of
 	 *             the separation
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension), typename Id>
 	std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> separateByPermutationsWithLines(
 	  const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry,
-	  const std::vector<std::vector<unsigned int>>& hyp_permutations_table,
+	  const PermutationTable<Id>& hyp_permutations_table,
 	  unsigned int permutations_number
 	);
 
@@ -105,11 +128,17 @@ namespace segre {
 	 *             1. Step 1: Separates lines by coord permutation (see
 	 *             separateByPermutationsWithLines() for details)
 	 *
-	 *             2. Step 2: For each line of each subentry, apply all
+	 *             2. Step 2: For the first line of each subentry, apply all
 	 *             dimensions permutation to the line, if the permuted line is
 	 *             in the same subentry, do nothing, if the permuted line is in
 	 *             another subentry, join/merge the two subentries
 	 *
+	 *             Coordinates permutations are normal in the group: the orbit
+	 *             of a line is the union of the coordinates orbits of its
+	 *             dimensions permuted images, so one line per subentry is
+	 *             enough. The joined subentries are tracked by an UnionFind and
+	 *             keep the order of their first subentry.
+	 *
 	 * @param[in]  lines_table_entry                 The Veldkamp lines table
 	 *                                               entry (with lines)
 	 * @param[in]  hyp_coord_permutations_table      The hyperplanes coordinates
@@ -122,153 +151,406 @@ namespace segre {
 	 *                                               of the geometry
 	 * @tparam     NbrPoints                         Number of points of the
 	 *                                               geometry
+	 * @tparam     Id                                Type of the hyperplanes ids
 	 *
 	 * @return     The Veldkamp lines table entries resulting of the separation
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension), typename Id>
 	std::vector<VeldkampLineTableEntry> separateBy2StepsPermutations(
 	  const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry,
-	  const std::vector<std::vector<unsigned int>>& hyp_coord_permutations_table,
-	  const std::vector<std::vector<unsigned int>>& hyp_dimension_permutations_table
+	  const PermutationTable<Id>& hyp_coord_permutations_table,
+	  const PermutationTable<Id>& hyp_dimension_permutations_table
 	);
 
 	/*------------------------------------------------------------------------*//**
 	 * @brief      Separate entries of a Veldkamp lines table by permutations
 	 *
 	 * @details    See separateByPermutations() on a Veldkamp line table entry
-	 *             for separation method details.
+	 *             for separation method details. The entries are separated in
+	 *             parallel, see separateEntries().
 	 *
 	 * @param[in]  lin_table_with_lines    The Veldkamp lines table (with lines)
 	 * @param[in]  hyp_permutations_table  The hyperplanes permutations table
 	 *                                     (see makePermutationsTable())
+	 * @param[out] entries_durations       If not null, the time spent on each
+	 *                                     entry of @p lin_table_with_lines
 	 *
 	 * @tparam     Dimension               Dimension of the geometry
 	 * @tparam     NbrPointsPerLine        Number of points per lines of the
 	 *                                     geometry
+	 * @tparam     Backend                 The parallel backend separating the
+	 *                                     entries
 	 * @tparam     NbrPoints               Number of points of the geometry
+	 * @tparam     Id                      Type of the hyperplanes ids
 	 *
 	 * @return     The Veldkamp lines table resulting of the separation
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension), typename Id>
 	std::vector<VeldkampLineTableEntry> separateByPermutations(
 	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
-	  const std::vector<std::vector<unsigned int>>& hyp_permutations_table
+	  const PermutationTable<Id>& hyp_permutations_table,
+	  std::vector<std::chrono::duration<double>>* entries_durations = nullptr
 	);
 
 	/*------------------------------------------------------------------------*//**
 	 * @brief      Separate entries of a Veldkamp lines table by 2 steps
 	 *             permutations.
 	 *
+	 * @details    The entries are separated in parallel, see
+	 *             separateEntries().
+	 *
 	 * @param[in]  lin_table_with_lines              The Veldkamp lines table
 	 *                                               (with lines)
 	 * @param[in]  hyp_coord_permutations_table      The hyperplanes coordinates
 	 *                                               permutations table
 	 * @param[in]  hyp_dimension_permutations_table  The hyperplanes dimensions
 	 *                                               permutations table
+	 * @param[out] entries_durations                 If not null, the time
+	 *                                               spent on each entry of @p
+	 *                                               lin_table_with_lines
 	 *
 	 * @tparam     Dimension                         Dimension of the geometry
 	 * @tparam     NbrPointsPerLine                  Number of points per lines
 	 *                                               of the geometry
+	 * @tparam     Backend                           The parallel backend
+	 *                                               separating the entries
 	 * @tparam     NbrPoints                         Number of points of the
 	 *                                               geometry
+	 * @tparam     Id                                Type of the hyperplanes ids
 	 *
 	 * @return     The Veldkamp lines table resulting of the separation
 	 */
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension), typename Id>
 	std::vector<VeldkampLineTableEntry> separateBy2StepsPermutations(
 	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
-	  const std::vector<std::vector<unsigned int>>& hyp_coord_permutations_table,
-	  const std::vector<std::vector<unsigned int>>& hyp_dimension_permutations_table
+	  const PermutationTable<Id>& hyp_coord_permutations_table,
+	  const PermutationTable<Id>& hyp_dimension_permutations_table,
+	  std::vector<std::chrono::duration<double>>* entries_durations = nullptr
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Separate entries of a Veldkamp lines table by orbits of the
+	 *             symmetry group.
+	 *
+	 * @details    Gives the same separation as separateByPermutations()
+	 *             without permutations table: the generators of the
+	 *             SymmetryGroup are applied to each line of an entry and each
+	 *             line is joined with its images by an UnionFind, the orbits
+	 *             are the resulting sets. The entries are separated in
+	 *             parallel, see separateEntries().
+	 *
+	 * @param[in]  lin_table_with_lines  The Veldkamp lines table (with lines)
+	 * @param[in]  hyperplanes           The hyperplanes the lines are made of
+	 * @param[in]  hyperplanes_index     The index of @p hyperplanes
+	 * @param[out] entries_durations     If not null, the time spent on each
+	 *                                   entry of @p lin_table_with_lines
+	 *
+	 * @tparam     Dimension             Dimension of the geometry
+	 * @tparam     NbrPointsPerLine      Number of points per lines of the
+	 *                                   geometry
+	 * @tparam     Backend               The parallel backend
+	 * @tparam     NbrPoints             Number of points of the geometry
+	 *
+	 * @return     The Veldkamp lines table resulting of the separation
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::vector<VeldkampLineTableEntry> separateByGroupOrbits(
+	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index,
+	  std::vector<std::chrono::duration<double>>* entries_durations = nullptr
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Separate entries of a Veldkamp lines table by canonical
+	 *             forms.
+	 *
+	 * @details    Gives the same separation as separateByPermutations() without
+	 *             permutations table: the lines of an entry are grouped by
+	 *             canonical form (see computeCanonicalVeldkampLine()), the
+	 *             subentries are in the order of their first line.
+	 *
+	 *             The lines are first grouped by the sorted canonical forms of
+	 *             their hyperplanes (see computeCanonicalHyperplane()), cached
+	 *             for all the entries. A line alone in its group is alone in
+	 *             its orbit and doesn't need its canonical form.
+	 *
+	 * @param[in]  lin_table_with_lines  The Veldkamp lines table (with lines)
+	 * @param[in]  hyperplanes           The hyperplanes the lines are made of
+	 *
+	 * @tparam     Dimension             Dimension of the geometry
+	 * @tparam     NbrPointsPerLine      Number of points per lines of the
+	 *                                   geometry
+	 * @tparam     Backend               The parallel backend computing the
+	 *                                   canonical forms
+	 * @tparam     NbrPoints             Number of points of the geometry
+	 *
+	 * @return     The Veldkamp lines table resulting of the separation
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::vector<VeldkampLineTableEntry> separateByCanonicalForms(
+	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates the orbits of the Veldkamp lines under the
+	 *             symmetry group, without enumerating all the lines.
+	 *
+	 * @details    Every orbit has a line through the representative @c r of
+	 *             an hyperplanes orbit, and then through @c r and the
+	 *             representative @c x of an orbit of the stabilizer of @c r.
+	 *             Only the lines through these pairs are enumerated, and they
+	 *             are grouped by canonical form (see
+	 *             computeCanonicalVeldkampLine()).
+	 *
+	 *             Each line through @c r and @c x stands for the size of the
+	 *             orbit of @c x under the stabilizer: summed on an orbit @c O,
+	 *             this gives (@p NbrPointsPerLine - 1) times the number of
+	 *             lines of @c O through @c r. With @c k the number of
+	 *             hyperplanes of a line of @c O in the orbit of @c r, the size
+	 *             of @c O is |orbit(@c r)| * (lines of @c O through @c r) / @c
+	 *             k.
+	 *
+	 * @param[in]  hyperplanes        The hyperplanes of the geometry
+	 * @param[in]  hyperplanes_index  The index of @p hyperplanes
+	 *
+	 * @tparam     Dimension          Dimension of the geometry
+	 * @tparam     NbrPointsPerLine   Number of points per lines of the
+	 *                                geometry
+	 * @tparam     Backend            The parallel backend enumerating the
+	 *                                lines
+	 * @tparam     NbrPoints          Number of points of the geometry
+	 *
+	 * @return     The orbits, in the order they are found
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::vector<VeldkampLineOrbit<NbrPointsPerLine>> computeVeldkampLineOrbits(
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates all the Veldkamp lines from their orbits.
+	 *
+	 * @details    The orbit of each representative is walked with the
+	 *             generators of the SymmetryGroup.
+	 *
+	 * @param[in]  orbits             The orbits (see
+	 *                                computeVeldkampLineOrbits())
+	 * @param[in]  hyperplanes        The hyperplanes of the geometry
+	 * @param[in]  hyperplanes_index  The index of @p hyperplanes
+	 *
+	 * @tparam     Dimension          Dimension of the geometry
+	 * @tparam     NbrPointsPerLine   Number of points per lines of the
+	 *                                geometry
+	 * @tparam     NbrPoints          Number of points of the geometry
+	 *
+	 * @return     The lines, sorted and in lexicographic order as enumerated
+	 *             by PointGeometry::computeVeldkampLinesTable()
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	std::vector<std::array<unsigned int, NbrPointsPerLine>> expandVeldkampLineOrbits(
+	  const std::vector<VeldkampLineOrbit<NbrPointsPerLine>>& orbits,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates the Veldkamp lines table of a geometry without
+	 *             enumerating its lines, for the geometries whose lines don't
+	 *             fit in memory.
+	 *
+	 * @details    The table entries are invariant under the symmetry group.
+	 *             Summed over the ordered pairs (@c h, @c y) of hyperplanes,
+	 *             the lines through @c h and @c y count each line
+	 *             @p NbrPointsPerLine * (@p NbrPointsPerLine - 1) times, and
+	 *             the pairs with @c h in the orbit of a representative @c r
+	 *             count as |orbit(@c r)| times the pairs (@c r, @c x), @c x
+	 *             representative of an orbit of the stabilizer of @c r,
+	 *             weighted by the size of the orbit of @c x (see
+	 *             computeVeldkampLineOrbits()).
+	 *
+	 *             The lines through @c r and @c x are made of the hyperplanes
+	 *             having their core with both: their linear forms vanish on
+	 *             the core, so they are found among the hyperplanes of the
+	 *             normalized forms of the kernel of the core (see
+	 *             computeVanishingLinearForms()) instead of among all the
+	 *             hyperplanes. A core of rank @c TensorSize - @c k has (3^@c k
+	 *             - 1) / 2 such forms, 4 for the cores of a single line.
+	 *
+	 *             The pairs of an hyperplanes orbit are split in blocks of
+	 *             about VELDKAMP_LINES_BLOCK_WORK forms, each block writing the
+	 *             weights of its entries to the run file
+	 *             "lines_<orbit>_<block>" of @p directory. The file
+	 *             "checkpoint_<orbit>" records the completed blocks of an
+	 *             orbit, and "checkpoint" the completed orbits: a computation
+	 *             restarted on the same directory after an interruption only
+	 *             processes the remaining blocks.
+	 *
+	 * @param[in]  geometry           The geometry
+	 * @param[in]  hyperplanes        The hyperplanes of the geometry
+	 * @param[in]  hyperplanes_index  The index of @p hyperplanes
+	 * @param[in]  hyperplanes_types  The type of each hyperplane (see
+	 *                                HyperplanesTable)
+	 * @param[in]  nextGeometry       The next geometry, used to build the
+	 *                                matrix associated to the hyperplanes
+	 * @param[in]  directory          The directory of the computation
+	 * @param[out] table              The lines table, the one of
+	 *                                PointGeometry::computeVeldkampLinesTable()
+	 *
+	 * @tparam     Dimension          Dimension of the geometry
+	 * @tparam     NbrPointsPerLine   Number of points per lines of the
+	 *                                geometry, 4 as the forms are over GF(3)
+	 * @tparam     Backend            The parallel backend
+	 *
+	 * @return     False and a message on std::cerr if a file couldn't be read
+	 *             or written
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend = ParallelBackend::Sequential, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	bool computeVeldkampLinesTableOutOfCore(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index,
+	  const std::vector<unsigned int>& hyperplanes_types,
+	  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry,
+	  const std::string& directory,
+	  std::vector<VeldkampLineTableEntry>& table
+	);
+
+	constexpr size_t VELDKAMP_LINES_BLOCK_WORK = size_t{1} << 24U; // Linear forms tried per block of computeVeldkampLinesTableOutOfCore()
+}
+
+namespace segre::detail {
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Hash function object of sorted Veldkamp lines.
+	 */
+	template<size_t NbrPointsPerLine>
+	struct SortedLineHash {
+		size_t operator()(const std::array<unsigned int, NbrPointsPerLine>& line) const;
+	};
+
+	template<size_t NbrPointsPerLine>
+	using SortedLinesIndex = FlatHashMap<std::array<unsigned int, NbrPointsPerLine>, unsigned int, SortedLineHash<NbrPointsPerLine>>;
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Map the sorted lines of @p lines to their position.
+	 */
+	template<size_t NbrPointsPerLine>
+	SortedLinesIndex<NbrPointsPerLine> makeSortedLinesIndex(const std::vector<std::array<unsigned int, NbrPointsPerLine>>& lines);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Position of the line @p line permuted by the permutation
+	 *             number @p permutation_number, the permuted line must be in
+	 *             @p lines_index.
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, typename Id>
+	unsigned int findPermutedLine(
+	  const std::array<unsigned int, NbrPointsPerLine>& line,
+	  const SortedLinesIndex<NbrPointsPerLine>& lines_index,
+	  const PermutationTable<Id>& hyp_permutations_table,
+	  size_t permutation_number
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates the orbits of @p lines under the permutations of
+	 *             @p hyp_permutations_table.
+	 *
+	 * @details    See separateByPermutations(): an orbit starts with its first
+	 *             line, followed by the other lines in the order the
+	 *             permutations reach them, the orbits are in the order of their
+	 *             first line.
+	 *
+	 * @return     The positions in @p lines of the lines of each orbit
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, typename Id>
+	std::vector<std::vector<unsigned int>> computeLinesOrbits(
+	  const std::vector<std::array<unsigned int, NbrPointsPerLine>>& lines,
+	  const SortedLinesIndex<NbrPointsPerLine>& lines_index,
+	  const PermutationTable<Id>& hyp_permutations_table,
+	  unsigned int permutations_number
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Separate the entries of a Veldkamp lines table in parallel.
+	 *
+	 * @details    The entries are independent and of very uneven sizes: they
+	 *             are given to the workers as they get free, the entries with
+	 *             the most lines first (see parallelTasks()). The results are
+	 *             concatenated in the order of @p lin_table_with_lines.
+	 *
+	 * @param[in]  lin_table_with_lines  The Veldkamp lines table (with lines)
+	 * @param[in]  separate              Function called as separate(entry),
+	 *                                   returning the subentries of an entry
+	 * @param[out] entries_durations     If not null, the time spent on each
+	 *                                   entry
+	 *
+	 * @tparam     Backend               The parallel backend
+	 * @tparam     NbrPointsPerLine      Number of points per lines of the
+	 *                                   geometry
+	 * @tparam     Separate              Type of @p separate
+	 *
+	 * @return     The Veldkamp lines table resulting of the separation
+	 */
+	template<ParallelBackend Backend, size_t NbrPointsPerLine, typename Separate>
+	std::vector<VeldkampLineTableEntry> separateEntries(
+	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
+	  const Separate& separate,
+	  std::vector<std::chrono::duration<double>>* entries_durations
+	);
+
+	/*------------------------------------------------------------------------*//**
+	 * @brief      Calculates the orbits of the hyperplanes under the
+	 *             stabilizer of the hyperplane @p hyperplane (see
+	 *             computeHyperplaneStabilizer()).
+	 */
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, size_t NbrPoints>
+	HyperplaneOrbits computeStabilizerOrbits(
+	  const SymmetryGroup<Dimension, NbrPointsPerLine>& group,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index,
+	  unsigned int hyperplane
 	);
 }
 
 // Implementations
 namespace segre {
 
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
-	std::array<unsigned int, NbrPointsPerLine> applyPermutation(const std::array<unsigned int, NbrPointsPerLine>& line, const std::vector<std::vector<unsigned int>>& hyp_permutations_table, size_t permutation_number) {
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints, typename Id>
+	std::array<unsigned int, NbrPointsPerLine> applyPermutation(const std::array<unsigned int, NbrPointsPerLine>& line, const PermutationTable<Id>& hyp_permutations_table, size_t permutation_number) {
 		std::array<unsigned int, NbrPointsPerLine> permuted_line;
 		for(size_t i = 0; i < NbrPointsPerLine; ++i){
-			permuted_line[i] = hyp_permutations_table[line[i]][permutation_number];
+			permuted_line[i] = hyp_permutations_table(line[i], permutation_number);
 		}
 		return permuted_line;
 	}
 
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
-	std::vector<VeldkampLineTableEntry> separateByPermutations(const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry, const std::vector<std::vector<unsigned int>>& hyp_permutations_table, unsigned int permutations_number) {
-		std::vector<VeldkampLineTableEntry> output_table;
-		std::vector<std::array<unsigned int, NbrPointsPerLine>> sorted_lines(lines_table_entry.lines);
-		std::for_each(sorted_lines.begin(), sorted_lines.end(), [](std::array<unsigned int, NbrPointsPerLine>& line){std::sort(line.begin(), line.end());});
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints, typename Id>
+	std::vector<VeldkampLineTableEntry> separateByPermutations(const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry, const PermutationTable<Id>& hyp_permutations_table, unsigned int permutations_number) {
+		const detail::SortedLinesIndex<NbrPointsPerLine> lines_index = detail::makeSortedLinesIndex(lines_table_entry.lines);
 
-		std::vector<bool> flags;
-		flags.reserve(lines_table_entry.lines.size());
-		for(size_t i = 0; i < lines_table_entry.lines.size(); ++i){
-			flags.push_back(false);
-		}
-		while(true){
-			const size_t pos = static_cast<const size_t>(std::find(flags.cbegin(), flags.cend(), false) - flags.cbegin());
-			if(pos >= flags.size()) {
-				break;
-			}
-			const std::array<unsigned int, NbrPointsPerLine>& line = lines_table_entry.lines[pos];
-			flags[pos] = true;
+		std::vector<VeldkampLineTableEntry> output_table;
+		for(const std::vector<unsigned int>& orbit : detail::computeLinesOrbits<Dimension, NbrPointsPerLine>(lines_table_entry.lines, lines_index, hyp_permutations_table, permutations_number)){
 			VeldkampLineTableEntry table_entry = lines_table_entry.entry;
-			table_entry.count = 1;
-			for(size_t i = 0; i < permutations_number; ++i){
-				std::array<unsigned int, NbrPointsPerLine> permuted_line = applyPermutation<Dimension, NbrPointsPerLine>(line, hyp_permutations_table, i);
-				std::sort(permuted_line.begin(), permuted_line.end());
-				const size_t pos2 = static_cast<const size_t>(std::find(sorted_lines.cbegin(), sorted_lines.cend(), permuted_line) - sorted_lines.cbegin());
-				if(pos2 < sorted_lines.size()) {
-					if(!flags[pos2]){
-						flags[pos2] = true;
-						++table_entry.count;
-					}
-				}
-				else{
-					IMPOSSIBLE;
-				}
-			}
+			table_entry.count = static_cast<unsigned int>(orbit.size());
 			output_table.push_back(std::move(table_entry));
 		}
 
 		return output_table;
 	}
 
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
-	std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> separateByPermutationsWithLines(const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry, const std::vector<std::vector<unsigned int>>& hyp_permutations_table, unsigned int permutations_number) {
-		std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> output_table;
-		std::vector<std::array<unsigned int, NbrPointsPerLine>> sorted_lines(lines_table_entry.lines);
-		std::for_each(sorted_lines.begin(), sorted_lines.end(), [](std::array<unsigned int, NbrPointsPerLine>& line){std::sort(line.begin(), line.end());});
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints, typename Id>
+	std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> separateByPermutationsWithLines(const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry, const PermutationTable<Id>& hyp_permutations_table, unsigned int permutations_number) {
+		const detail::SortedLinesIndex<NbrPointsPerLine> lines_index = detail::makeSortedLinesIndex(lines_table_entry.lines);
 
-		std::vector<bool> flags;
-		flags.reserve(lines_table_entry.lines.size());
-		for(size_t i = 0; i < lines_table_entry.lines.size(); ++i){
-			flags.push_back(false);
-		}
-		while(true){
-			const size_t pos = static_cast<const size_t>(std::find(flags.cbegin(), flags.cend(), false) - flags.cbegin());
-			if(pos >= flags.size()) {
-				break;
-			}
-			const std::array<unsigned int, NbrPointsPerLine>& line = lines_table_entry.lines[pos];
-			flags[pos] = true;
+		std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> output_table;
+		for(const std::vector<unsigned int>& orbit : detail::computeLinesOrbits<Dimension, NbrPointsPerLine>(lines_table_entry.lines, lines_index, hyp_permutations_table, permutations_number)){
 			VeldkampLineTableEntryWithLines<NbrPointsPerLine> table_entry(lines_table_entry.entry);
-			table_entry.entry.count = 1;
-			table_entry.lines.push_back(line);
-			for(size_t i = 0; i < permutations_number; ++i){
-				std::array<unsigned int, NbrPointsPerLine> permuted_line = applyPermutation<Dimension, NbrPointsPerLine>(line, hyp_permutations_table, i);
-				std::sort(permuted_line.begin(), permuted_line.end());
-				const size_t pos2 = static_cast<const size_t>(std::find(sorted_lines.cbegin(), sorted_lines.cend(), permuted_line) - sorted_lines.cbegin());
-				if(pos2 < sorted_lines.size()) {
-					if(!flags[pos2]){
-						flags[pos2] = true;
-						++table_entry.entry.count;
-						table_entry.lines.push_back(lines_table_entry.lines[pos2]);
-					}
-				}
-				else{
-					IMPOSSIBLE;
-				}
+			table_entry.entry.count = static_cast<unsigned int>(orbit.size());
+			table_entry.lines.reserve(orbit.size());
+			for(unsigned int i_line : orbit){
+				table_entry.lines.push_back(lines_table_entry.lines[i_line]);
 			}
 			output_table.push_back(std::move(table_entry));
 		}
@@ -276,108 +558,653 @@ namespace segre {
 		return output_table;
 	}
 
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints, typename Id>
 	std::vector<VeldkampLineTableEntry> separateBy2StepsPermutations(
 	  const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry,
-	  const std::vector<std::vector<unsigned int>>& hyp_coord_permutations_table,
-	  const std::vector<std::vector<unsigned int>>& hyp_dimension_permutations_table
+	  const PermutationTable<Id>& hyp_coord_permutations_table,
+	  const PermutationTable<Id>& hyp_dimension_permutations_table
 	){
+		const detail::SortedLinesIndex<NbrPointsPerLine> lines_index = detail::makeSortedLinesIndex(lines_table_entry.lines);
+
 		// Separate by coord permutations
-		std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>> coord_permuted_entries =
-		  separateByPermutationsWithLines<Dimension, NbrPointsPerLine>(
-		    lines_table_entry,
-		      hyp_coord_permutations_table,
-		      decltype(makeCoordPermutationsGenerator<Dimension, NbrPointsPerLine>())::getPermutationsNumber()
-		  );
-
-		// Prepare table of sorted entries lines
-		std::vector<std::vector<std::array<unsigned int, NbrPointsPerLine>>> entries_sorted_lines;
-		entries_sorted_lines.resize(coord_permuted_entries.size());
-		for(unsigned int i_entry = 0; i_entry < coord_permuted_entries.size(); ++i_entry){
-			entries_sorted_lines[i_entry].reserve(coord_permuted_entries[i_entry].lines.size());
-			for(unsigned int i_line = 0; i_line < coord_permuted_entries[i_entry].lines.size(); ++i_line){
-				std::array<unsigned int, NbrPointsPerLine> sorted_line = coord_permuted_entries[i_entry].lines[i_line];
-				std::sort(sorted_line.begin(), sorted_line.end());
-				entries_sorted_lines[i_entry].push_back(std::move(sorted_line));
+		const std::vector<std::vector<unsigned int>> coord_orbits = detail::computeLinesOrbits<Dimension, NbrPointsPerLine>(
+		  lines_table_entry.lines,
+		  lines_index,
+		  hyp_coord_permutations_table,
+		  decltype(makeCoordPermutationsGenerator<Dimension, NbrPointsPerLine>())::getPermutationsNumber()
+		);
+		std::vector<unsigned int> line_coord_orbit(lines_table_entry.lines.size());
+		for(unsigned int i_orbit = 0; i_orbit < coord_orbits.size(); ++i_orbit){
+			for(unsigned int i_line : coord_orbits[i_orbit]){
+				line_coord_orbit[i_line] = i_orbit;
 			}
 		}
 
-		// Prepare processed entries joined flags and output table position
-		std::vector<bool> entry_is_joined;
-		std::vector<unsigned int> entry_output_table_pos;
-		entry_is_joined.resize(coord_permuted_entries.size(), false);
-		entry_output_table_pos.resize(coord_permuted_entries.size(), 0);
+		// Join coord orbits with dimensions permutations
+		UnionFind joined_orbits(coord_orbits.size());
+		for(unsigned int i_orbit = 0; i_orbit < coord_orbits.size(); ++i_orbit){
+			const std::array<unsigned int, NbrPointsPerLine>& line = lines_table_entry.lines[coord_orbits[i_orbit].front()];
+			for(size_t i_permutation = 0; i_permutation < PermutationGenerator<Dimension>::getPermutationsNumber(); ++i_permutation){
+				const unsigned int i_line = detail::findPermutedLine<Dimension, NbrPointsPerLine>(line, lines_index, hyp_dimension_permutations_table, i_permutation);
+				joined_orbits.unite(i_orbit, line_coord_orbit[i_line]);
+			}
+		}
 
-		// Process entries: join with dimensions permutations
+		// Roots are the first orbit of each group: they are met before the other orbits of their group
 		std::vector<VeldkampLineTableEntry> output_table;
-		for(unsigned int i_entry = 0; i_entry < coord_permuted_entries.size(); ++i_entry){
-			const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& entry = coord_permuted_entries[i_entry];
-			if(entry_is_joined[i_entry]){
-				output_table[entry_output_table_pos[i_entry]].count += coord_permuted_entries[i_entry].entry.count;
+		std::vector<unsigned int> root_output_table_pos(coord_orbits.size(), 0);
+		for(unsigned int i_orbit = 0; i_orbit < coord_orbits.size(); ++i_orbit){
+			const unsigned int root = joined_orbits.find(i_orbit);
+			if(root == i_orbit){
+				root_output_table_pos[root] = static_cast<unsigned int>(output_table.size());
+				output_table.push_back(lines_table_entry.entry);
+				output_table.back().count = 0;
+			}
+			output_table[root_output_table_pos[root]].count += static_cast<unsigned int>(coord_orbits[i_orbit].size());
+		}
+
+		return output_table;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, size_t NbrPoints, typename Id>
+	std::vector<VeldkampLineTableEntry> separateByPermutations(
+	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
+	  const PermutationTable<Id>& hyp_permutations_table,
+	  std::vector<std::chrono::duration<double>>* entries_durations
+	){
+		return detail::separateEntries<Backend>(lin_table_with_lines, [&](const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry){
+			return separateByPermutations<Dimension, NbrPointsPerLine>(lines_table_entry, hyp_permutations_table, decltype(makeMultiPermutationsGenerator<Dimension, NbrPointsPerLine>())::getPermutationsNumber());
+		}, entries_durations);
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, size_t NbrPoints, typename Id>
+	std::vector<VeldkampLineTableEntry> separateBy2StepsPermutations(
+	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
+	  const PermutationTable<Id>& hyp_coord_permutations_table,
+	  const PermutationTable<Id>& hyp_dimension_permutations_table,
+	  std::vector<std::chrono::duration<double>>* entries_durations
+	){
+		return detail::separateEntries<Backend>(lin_table_with_lines, [&](const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry){
+			return separateBy2StepsPermutations<Dimension, NbrPointsPerLine>(lines_table_entry, hyp_coord_permutations_table, hyp_dimension_permutations_table);
+		}, entries_durations);
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, size_t NbrPoints>
+	std::vector<VeldkampLineTableEntry> separateByGroupOrbits(
+	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index,
+	  std::vector<std::chrono::duration<double>>* entries_durations
+	){
+		const SymmetryGroup<Dimension, NbrPointsPerLine> group;
+		const std::vector<std::vector<unsigned int>> generators_actions = group.template computeGeneratorsActions<Backend>(hyperplanes, hyperplanes_index);
+
+		return detail::separateEntries<Backend>(lin_table_with_lines, [&generators_actions](const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry){
+			const detail::SortedLinesIndex<NbrPointsPerLine> lines_index = detail::makeSortedLinesIndex(lines_table_entry.lines);
+
+			UnionFind orbits(lines_table_entry.lines.size());
+			for(unsigned int i_line = 0; i_line < lines_table_entry.lines.size(); ++i_line){
+				for(const std::vector<unsigned int>& generator_action : generators_actions){
+					std::array<unsigned int, NbrPointsPerLine> permuted_line;
+					for(size_t i = 0; i < NbrPointsPerLine; ++i){
+						permuted_line[i] = generator_action[lines_table_entry.lines[i_line][i]];
+					}
+					std::sort(permuted_line.begin(), permuted_line.end());
+					const unsigned int* i_permuted_line = lines_index.find(permuted_line);
+					if(i_permuted_line == nullptr){
+						IMPOSSIBLE;
+					}
+					orbits.unite(i_line, *i_permuted_line);
+				}
 			}
-			else{
-				entry_is_joined[i_entry] = true;
-				entry_output_table_pos[i_entry] = static_cast<unsigned int>(output_table.size());
-				output_table.push_back(coord_permuted_entries[i_entry].entry);
+
+			// Roots are the first line of each orbit
+			std::vector<VeldkampLineTableEntry> output_table;
+			std::vector<unsigned int> root_output_table_pos(lines_table_entry.lines.size(), 0);
+			for(unsigned int i_line = 0; i_line < lines_table_entry.lines.size(); ++i_line){
+				const unsigned int root = orbits.find(i_line);
+				if(root == i_line){
+					root_output_table_pos[root] = static_cast<unsigned int>(output_table.size());
+					output_table.push_back(lines_table_entry.entry);
+					output_table.back().count = 0;
+				}
+				++output_table[root_output_table_pos[root]].count;
 			}
+			return output_table;
+		}, entries_durations);
+	}
 
-			for(const std::array<unsigned int, NbrPointsPerLine> line : entry.lines){
-				for(size_t i_permutation = 0; i_permutation < PermutationGenerator<Dimension>::getPermutationsNumber(); ++i_permutation){
-					std::array<unsigned int, NbrPointsPerLine> permuted_line = applyPermutation<Dimension, NbrPointsPerLine>(line, hyp_dimension_permutations_table, i_permutation);
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, size_t NbrPoints>
+	std::vector<VeldkampLineOrbit<NbrPointsPerLine>> computeVeldkampLineOrbits(
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index
+	){
+		using Canonical = CanonicalVeldkampLine<NbrPointsPerLine, NbrPoints>;
+		struct FoundLine {
+			Canonical canonical;
+			std::array<unsigned int, NbrPointsPerLine> line;
+			size_t weight;
+		};
+
+		const SymmetryGroup<Dimension, NbrPointsPerLine> group;
+		const HyperplaneOrbits hyperplane_orbits = group.computeOrbits(group.template computeGeneratorsActions<Backend>(hyperplanes, hyperplanes_index));
+
+		std::vector<VeldkampLineOrbit<NbrPointsPerLine>> line_orbits;
+		FlatHashMap<Canonical, unsigned int, CanonicalVeldkampLineHash<NbrPointsPerLine, NbrPoints>> line_orbits_index;
+
+		for(unsigned int hyperplane_orbit = 0; hyperplane_orbit < hyperplane_orbits.representatives.size(); ++hyperplane_orbit){
+			const unsigned int r = hyperplane_orbits.representatives[hyperplane_orbit];
+
+			const HyperplaneOrbits stabilizer_orbits = detail::computeStabilizerOrbits<Dimension, NbrPointsPerLine, Backend>(group, hyperplanes, hyperplanes_index, r);
+
+			// Lines through r and each stabilizer orbit representative
+			std::vector<std::vector<FoundLine>> chunks_lines(getWorkersNumber<Backend>());
+			parallelChunks<Backend>(stabilizer_orbits.representatives.size(), [&](size_t chunk, size_t begin, size_t end){
+				std::vector<unsigned int> same_core;
+				for(size_t i = begin; i < end; ++i){
+					const unsigned int x = stabilizer_orbits.representatives[i];
+					if(x == r){
+						continue;
+					}
+					const std::bitset<NbrPoints> core = hyperplanes[r] & hyperplanes[x];
+
+					same_core.clear();
+					for(unsigned int h = 0; h < hyperplanes.size(); ++h){
+						if((hyperplanes[r] & hyperplanes[h]) == core && (hyperplanes[x] & hyperplanes[h]) == core){
+							same_core.push_back(h);
+						}
+					}
+
+					for(size_t c = 0; c < same_core.size(); ++c){
+						for(size_t d = c + 1; d < same_core.size(); ++d){
+							if((hyperplanes[same_core[c]] & hyperplanes[same_core[d]]) != core){
+								continue;
+							}
+							std::array<unsigned int, NbrPointsPerLine> line = {{r, x, same_core[c], same_core[d]}};
+							std::sort(line.begin(), line.end());
+							chunks_lines[chunk].push_back({computeCanonicalVeldkampLine<Dimension, NbrPointsPerLine>(line, hyperplanes), line, stabilizer_orbits.sizes[i]});
+						}
+					}
+				}
+			});
+
+			// Lines of each orbit through r, times NbrPointsPerLine - 1
+			std::vector<size_t> weights(line_orbits.size(), 0);
+			for(const std::vector<FoundLine>& chunk_lines : chunks_lines){
+				for(const FoundLine& found_line : chunk_lines){
+					const auto [line_orbit, inserted] = line_orbits_index.insert(found_line.canonical, static_cast<unsigned int>(line_orbits.size()));
+					if(inserted){
+						line_orbits.push_back({found_line.line, 0});
+						weights.push_back(0);
+					}
+					weights[*line_orbit] += found_line.weight;
+				}
+			}
+
+			const size_t hyperplane_orbit_size = hyperplane_orbits.sizes[hyperplane_orbit];
+			for(size_t line_orbit = 0; line_orbit < line_orbits.size(); ++line_orbit){
+				if(weights[line_orbit] == 0){
+					continue;
+				}
+
+				size_t k = 0;
+				for(unsigned int h : line_orbits[line_orbit].representative){
+					k += hyperplane_orbits.orbits[h] == hyperplane_orbit;
+				}
+				const size_t numerator = hyperplane_orbit_size * weights[line_orbit];
+				const size_t denominator = (NbrPointsPerLine - 1) * k;
+				if(numerator % denominator != 0){
+					IMPOSSIBLE;
+				}
+
+				// All the hyperplanes orbits met by the lines of an orbit give the same size
+				if(line_orbits[line_orbit].size == 0){
+					line_orbits[line_orbit].size = numerator / denominator;
+				}
+				else if(line_orbits[line_orbit].size != numerator / denominator){
+					IMPOSSIBLE;
+				}
+			}
+		}
+
+		return line_orbits;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints>
+	std::vector<std::array<unsigned int, NbrPointsPerLine>> expandVeldkampLineOrbits(
+	  const std::vector<VeldkampLineOrbit<NbrPointsPerLine>>& orbits,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index
+	){
+		const SymmetryGroup<Dimension, NbrPointsPerLine> group;
+		const std::vector<std::vector<unsigned int>> generators_actions = group.computeGeneratorsActions(hyperplanes, hyperplanes_index);
+
+		size_t nbr_lines = 0;
+		for(const VeldkampLineOrbit<NbrPointsPerLine>& orbit : orbits){
+			nbr_lines += orbit.size;
+		}
+
+		std::vector<std::array<unsigned int, NbrPointsPerLine>> lines;
+		lines.reserve(nbr_lines);
+		detail::SortedLinesIndex<NbrPointsPerLine> lines_index(nbr_lines);
+		for(const VeldkampLineOrbit<NbrPointsPerLine>& orbit : orbits){
+			const size_t orbit_begin = lines.size();
+			lines_index.insert(orbit.representative, static_cast<unsigned int>(lines.size()));
+			lines.push_back(orbit.representative);
+			for(size_t i_line = orbit_begin; i_line < lines.size(); ++i_line){
+				for(const std::vector<unsigned int>& generator_action : generators_actions){
+					std::array<unsigned int, NbrPointsPerLine> permuted_line;
+					for(size_t i = 0; i < NbrPointsPerLine; ++i){
+						permuted_line[i] = generator_action[lines[i_line][i]];
+					}
 					std::sort(permuted_line.begin(), permuted_line.end());
+					if(lines_index.insert(permuted_line, static_cast<unsigned int>(lines.size())).second){
+						lines.push_back(permuted_line);
+					}
+				}
+			}
+			if(lines.size() - orbit_begin != orbit.size){
+				IMPOSSIBLE;
+			}
+		}
+
+		std::sort(lines.begin(), lines.end());
+		return lines;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, size_t NbrLines, size_t NbrPoints, size_t TensorSize>
+	bool computeVeldkampLinesTableOutOfCore(
+	  const PointGeometry<Dimension, NbrPointsPerLine, NbrLines, NbrPoints, TensorSize>& geometry,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index,
+	  const std::vector<unsigned int>& hyperplanes_types,
+	  const PointGeometry<Dimension + 1, NbrPointsPerLine, math::pow(NbrPointsPerLine, Dimension) * (1 + Dimension)>& nextGeometry,
+	  const std::string& directory,
+	  std::vector<VeldkampLineTableEntry>& table
+	){
+		namespace fs = std::experimental::filesystem;
+
+		static_assert(NbrPointsPerLine == 4, "The hyperplanes are the zeros of the linear forms over GF(3)");
+
+		using Form = std::array<unsigned int, TensorSize>;
+		using Entry = FlatVeldkampLineTableEntry<NbrPointsPerLine>;
+		using Record = VeldkampLineEntryRecord<NbrPointsPerLine>;
+
+		std::error_code error;
+		fs::create_directories(directory, error);
+		if(error){
+			std::cerr << "Failed to create directory " << directory << std::endl;
+			return false;
+		}
+
+		const SymmetryGroup<Dimension, NbrPointsPerLine> group;
+		const HyperplaneOrbits hyperplane_orbits = group.computeOrbits(group.template computeGeneratorsActions<Backend>(hyperplanes, hyperplanes_index));
+		const size_t nbr_orbits = hyperplane_orbits.representatives.size();
+
+		VeldkampLinesCheckpoint checkpoint(directory + "/checkpoint");
+		if(!checkpoint.restore(hyperplanes.size(), nbr_orbits)){
+			return false;
+		}
+
+		const auto runPath = [&directory](size_t orbit, size_t block){
+			return directory + "/lines_" + std::to_string(orbit) + "_" + std::to_string(block);
+		};
 
-					bool found = false;
-					for(unsigned int i_search_entry = 0; i_search_entry < coord_permuted_entries.size(); ++i_search_entry){
-						const size_t found_pos = static_cast<const size_t>(std::find(entries_sorted_lines[i_search_entry].begin(), entries_sorted_lines[i_search_entry].end(), permuted_line) - entries_sorted_lines[i_search_entry].begin());
-						if(found_pos < entries_sorted_lines[i_search_entry].size()){
-							if(entry_is_joined[i_search_entry] && entry_output_table_pos[i_search_entry] != entry_output_table_pos[i_entry]){
-								IMPOSSIBLE;
+		// The zeros of a form among the points are the hyperplane of the form
+		const std::vector<Form> points = geometry.buildMatrix(~std::bitset<NbrPoints>());
+
+		for(unsigned int orbit = 0; orbit < nbr_orbits; ++orbit){
+			if(checkpoint.isCompleted(orbit)){
+				continue;
+			}
+			const unsigned int r = hyperplane_orbits.representatives[orbit];
+			const HyperplaneOrbits stabilizer_orbits = detail::computeStabilizerOrbits<Dimension, NbrPointsPerLine, Backend>(group, hyperplanes, hyperplanes_index, r);
+			const std::vector<unsigned int>& representatives = stabilizer_orbits.representatives;
+
+			// Forms tried for the pair of each stabilizer orbit representative
+			std::vector<size_t> works(representatives.size(), 0);
+			parallelChunks<Backend>(representatives.size(), [&](size_t, size_t begin, size_t end){
+				for(size_t i = begin; i < end; ++i){
+					if(representatives[i] != r){
+						works[i] = (math::pow(size_t{3}, computeVanishingLinearForms(geometry, hyperplanes[r] & hyperplanes[representatives[i]]).size()) - 1) / 2;
+					}
+				}
+			});
+
+			// Blocks of consecutive representatives, the work of the pairs is very uneven
+			std::vector<size_t> blocks_begins = {0};
+			size_t block_work = 0;
+			for(size_t i = 0; i + 1 < representatives.size(); ++i){
+				block_work += works[i];
+				if(block_work >= VELDKAMP_LINES_BLOCK_WORK){
+					blocks_begins.push_back(i + 1);
+					block_work = 0;
+				}
+			}
+			const size_t nbr_blocks = blocks_begins.size();
+			blocks_begins.push_back(representatives.size());
+
+			VeldkampLinesCheckpoint orbit_checkpoint(directory + "/checkpoint_" + std::to_string(orbit));
+			if(!orbit_checkpoint.restore(hyperplanes.size(), nbr_blocks)){
+				return false;
+			}
+			std::vector<size_t> pending_blocks;
+			for(size_t block = 0; block < nbr_blocks; ++block){
+				if(!orbit_checkpoint.isCompleted(block)){
+					pending_blocks.push_back(block);
+				}
+			}
+
+			std::atomic<bool> failed(false);
+			parallelTasks<Backend>(pending_blocks.size(), [&](size_t task){
+				if(failed){
+					return;
+				}
+				const size_t block = pending_blocks[task];
+
+				EntriesCounter<Entry> entries;
+				std::vector<unsigned int> same_core;
+				for(size_t i = blocks_begins[block]; i < blocks_begins[block + 1]; ++i){
+					const unsigned int x = representatives[i];
+					if(x == r){
+						continue;
+					}
+					const std::bitset<NbrPoints> core = hyperplanes[r] & hyperplanes[x];
+					const std::bitset<NbrPoints> span = hyperplanes[r] | hyperplanes[x]; // (h & span) == core iff h has the same core with r and x
+
+					// Hyperplanes of the normalized forms vanishing on the core, the first non zero coefficient is 1
+					const std::vector<Form> core_forms = computeVanishingLinearForms(geometry, core);
+					const size_t nbr_combinations = math::pow(size_t{3}, core_forms.size());
+					same_core.clear();
+					for(size_t combination = 1; combination < nbr_combinations; ++combination){
+						Form form{};
+						bool normalized = false;
+						size_t digits = combination;
+						for(size_t j = 0; j < core_forms.size(); ++j, digits /= 3){
+							const unsigned int coefficient = static_cast<unsigned int>(digits % 3);
+							if(coefficient == 0){
+								continue;
+							}
+							if(!normalized && coefficient == 2){
+								break;
+							}
+							normalized = true;
+							for(size_t c = 0; c < TensorSize; ++c){
+								form[c] = (form[c] + coefficient * core_forms[j][c]) % 3;
 							}
-							// Join i_search_entry with current entry (i_entry)
-							entry_is_joined[i_search_entry] = true;
-							entry_output_table_pos[i_search_entry] = entry_output_table_pos[i_entry];
-							found = true;
-							break;
+						}
+						if(!normalized){
+							continue;
+						}
+
+						const unsigned int h = hyperplanes_index.find(computeLinearFormZeros<NbrPoints>(points, form));
+						if(h == HyperplaneIndex<NbrPoints>::NOT_FOUND){
+							IMPOSSIBLE;
+						}
+						if((hyperplanes[h] & span) == core){
+							same_core.push_back(h);
 						}
 					}
-					if(!found){
-						IMPOSSIBLE;
+
+					const size_t weight = size_t{hyperplane_orbits.sizes[orbit]} * stabilizer_orbits.sizes[i];
+					for(size_t c = 0; c < same_core.size(); ++c){
+						for(size_t d = c + 1; d < same_core.size(); ++d){
+							if((hyperplanes[same_core[c]] & hyperplanes[same_core[d]]) != core){
+								continue;
+							}
+							std::array<unsigned int, NbrPointsPerLine> line = {{r, x, same_core[c], same_core[d]}};
+							std::sort(line.begin(), line.end());
+
+							// Same classification as computeVeldkampLinesTable()
+							const bool isProjective = same_core.size() == 2 || geometry.hasDegenerateMatrix(line, hyperplanes, nextGeometry);
+							entries.add(geometry.makeLinesTableEntry(isProjective, line, hyperplanes, hyperplanes_types), weight);
+						}
 					}
 				}
+
+				RecordFileWriter<Record> run(runPath(orbit, block));
+				for(size_t i = 0; i < entries.getEntries().size(); ++i){
+					const Entry& entry = entries.getEntries()[i];
+					Record record;
+					record.weight = entries.getCounts()[i];
+					record.pointsType = entry.pointsType;
+					record.isProjective = entry.isProjective ? 1 : 0;
+					record.coreNbrPoints = entry.coreNbrPoints;
+					record.coreNbrLines = entry.coreNbrLines;
+					run.add(record);
+				}
+				if(!run.close() || !orbit_checkpoint.complete(block, 1)){
+					failed = true;
+				}
+			});
+			if(failed || !checkpoint.complete(orbit, nbr_blocks)){
+				return false;
 			}
 		}
 
-		return output_table;
+		EntriesCounter<Entry> entries;
+		for(size_t orbit = 0; orbit < nbr_orbits; ++orbit){
+			for(size_t block = 0; block < checkpoint.getRunsNumber(orbit); ++block){
+				const bool read = readRecordFile<Record>(runPath(orbit, block), [&entries](const Record& record){
+					Entry entry;
+					entry.isProjective = record.isProjective != 0;
+					entry.coreNbrPoints = record.coreNbrPoints;
+					entry.coreNbrLines = record.coreNbrLines;
+					entry.pointsType = record.pointsType;
+					entries.add(entry, record.weight);
+				});
+				if(!read){
+					return false;
+				}
+			}
+		}
+
+		// Each line has been counted from each ordered pair of its hyperplanes
+		constexpr size_t LINE_PAIRS = NbrPointsPerLine * (NbrPointsPerLine - 1);
+		table.clear();
+		table.reserve(entries.getEntries().size());
+		for(size_t i = 0; i < entries.getEntries().size(); ++i){
+			if(entries.getCounts()[i] % LINE_PAIRS != 0){
+				IMPOSSIBLE;
+			}
+			table.push_back(entries.getEntries()[i].toTableEntry(entries.getCounts()[i] / LINE_PAIRS));
+		}
+		return true;
 	}
 
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
-	std::vector<VeldkampLineTableEntry> separateByPermutations(
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, size_t NbrPoints>
+	std::vector<VeldkampLineTableEntry> separateByCanonicalForms(
 	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
-	  const std::vector<std::vector<unsigned int>>& hyp_permutations_table
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes
 	){
+		using LineForms = CanonicalVeldkampLine<NbrPointsPerLine, NbrPoints>;
+		using LineFormsHash = CanonicalVeldkampLineHash<NbrPointsPerLine, NbrPoints>;
+
+		// The lines are made of few distinct hyperplanes, shared by all the entries
+		CanonicalHyperplanesCache<NbrPoints> hyperplanes_cache;
+
 		std::vector<VeldkampLineTableEntry> output_table;
 		for(const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry : lin_table_with_lines){
-			for(VeldkampLineTableEntry& entry : separateByPermutations<Dimension, NbrPointsPerLine>(lines_table_entry, hyp_permutations_table, decltype(makeMultiPermutationsGenerator<Dimension, NbrPointsPerLine>())::getPermutationsNumber())){
-				output_table.push_back(std::move(entry));
+			const std::vector<std::array<unsigned int, NbrPointsPerLine>>& lines = lines_table_entry.lines;
+
+			// Lines of the same orbit have the same sorted hyperplanes canonical forms
+			std::vector<LineForms> hyperplanes_forms(lines.size());
+			parallelChunks<Backend>(lines.size(), [&](size_t, size_t begin, size_t end) {
+				for(size_t i = begin; i < end; ++i) {
+					for(size_t j = 0; j < NbrPointsPerLine; ++j) {
+						hyperplanes_forms[i][j] = computeCanonicalHyperplane<Dimension, NbrPointsPerLine>(hyperplanes[lines[i][j]], hyperplanes_cache);
+					}
+					std::sort(hyperplanes_forms[i].begin(), hyperplanes_forms[i].end(), BitsetLess<NbrPoints>());
+				}
+			});
+
+			std::vector<size_t> forms_groups(lines.size());
+			std::vector<size_t> forms_groups_sizes;
+			FlatHashMap<LineForms, size_t, LineFormsHash> forms_groups_ids;
+			for(size_t i = 0; i < lines.size(); ++i){
+				const std::pair<size_t*, bool> group = forms_groups_ids.insert(hyperplanes_forms[i], forms_groups_sizes.size());
+				if(group.second){
+					forms_groups_sizes.push_back(0);
+				}
+				forms_groups[i] = *group.first;
+				++forms_groups_sizes[forms_groups[i]];
+			}
+
+			// A line alone with its hyperplanes forms is alone in its orbit, its canonical form is not needed
+			std::vector<LineForms> canonical_lines(lines.size());
+			parallelChunks<Backend>(lines.size(), [&](size_t, size_t begin, size_t end) {
+				for(size_t i = begin; i < end; ++i) {
+					if(forms_groups_sizes[forms_groups[i]] > 1) {
+						canonical_lines[i] = computeCanonicalVeldkampLine<Dimension, NbrPointsPerLine>(lines[i], hyperplanes);
+					}
+				}
+			});
+
+			FlatHashMap<LineForms, size_t, LineFormsHash> output_positions;
+			for(size_t i = 0; i < lines.size(); ++i){
+				if(forms_groups_sizes[forms_groups[i]] == 1) {
+					output_table.push_back(lines_table_entry.entry);
+					output_table.back().count = 1;
+					continue;
+				}
+
+				const std::pair<size_t*, bool> position = output_positions.insert(canonical_lines[i], output_table.size());
+				if(position.second){
+					output_table.push_back(lines_table_entry.entry);
+					output_table.back().count = 1;
+				}
+				else{
+					++output_table[*position.first].count;
+				}
 			}
 		}
 		return output_table;
 	}
+}
 
-	template<size_t Dimension, size_t NbrPointsPerLine, size_t NbrPoints = math::pow(NbrPointsPerLine, Dimension)>
-	std::vector<VeldkampLineTableEntry> separateBy2StepsPermutations(
+namespace segre::detail {
+
+	template<size_t NbrPointsPerLine>
+	size_t SortedLineHash<NbrPointsPerLine>::operator()(const std::array<unsigned int, NbrPointsPerLine>& line) const {
+		std::uint64_t hash = 0;
+		for(unsigned int hyperplane : line) {
+			hash = hashCombine(hash, hyperplane);
+		}
+		return hash;
+	}
+
+	template<size_t NbrPointsPerLine>
+	SortedLinesIndex<NbrPointsPerLine> makeSortedLinesIndex(const std::vector<std::array<unsigned int, NbrPointsPerLine>>& lines) {
+		SortedLinesIndex<NbrPointsPerLine> lines_index(lines.size());
+		for(unsigned int i_line = 0; i_line < lines.size(); ++i_line){
+			std::array<unsigned int, NbrPointsPerLine> sorted_line = lines[i_line];
+			std::sort(sorted_line.begin(), sorted_line.end());
+			lines_index.insert(sorted_line, i_line);
+		}
+		return lines_index;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, typename Id>
+	unsigned int findPermutedLine(
+	  const std::array<unsigned int, NbrPointsPerLine>& line,
+	  const SortedLinesIndex<NbrPointsPerLine>& lines_index,
+	  const PermutationTable<Id>& hyp_permutations_table,
+	  size_t permutation_number
+	){
+		std::array<unsigned int, NbrPointsPerLine> permuted_line = applyPermutation<Dimension, NbrPointsPerLine>(line, hyp_permutations_table, permutation_number);
+		std::sort(permuted_line.begin(), permuted_line.end());
+		const unsigned int* i_line = lines_index.find(permuted_line);
+		if(i_line == nullptr){
+			IMPOSSIBLE;
+		}
+		return *i_line;
+	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, typename Id>
+	std::vector<std::vector<unsigned int>> computeLinesOrbits(
+	  const std::vector<std::array<unsigned int, NbrPointsPerLine>>& lines,
+	  const SortedLinesIndex<NbrPointsPerLine>& lines_index,
+	  const PermutationTable<Id>& hyp_permutations_table,
+	  unsigned int permutations_number
+	){
+		std::vector<std::vector<unsigned int>> orbits;
+		std::vector<bool> flags(lines.size(), false);
+		for(unsigned int i_first = 0; i_first < lines.size(); ++i_first){
+			if(flags[i_first]){
+				continue;
+			}
+			flags[i_first] = true;
+			std::vector<unsigned int> orbit{i_first};
+			for(size_t i = 0; i < permutations_number; ++i){
+				const unsigned int i_line = findPermutedLine<Dimension, NbrPointsPerLine>(lines[i_first], lines_index, hyp_permutations_table, i);
+				if(!flags[i_line]){
+					flags[i_line] = true;
+					orbit.push_back(i_line);
+				}
+			}
+			orbits.push_back(std::move(orbit));
+		}
+		return orbits;
+	}
+
+	template<ParallelBackend Backend, size_t NbrPointsPerLine, typename Separate>
+	std::vector<VeldkampLineTableEntry> separateEntries(
 	  const std::vector<VeldkampLineTableEntryWithLines<NbrPointsPerLine>>& lin_table_with_lines,
-	  const std::vector<std::vector<unsigned int>>& hyp_coord_permutations_table,
-	  const std::vector<std::vector<unsigned int>>& hyp_dimension_permutations_table
+	  const Separate& separate,
+	  std::vector<std::chrono::duration<double>>* entries_durations
 	){
+		std::vector<size_t> entries_order(lin_table_with_lines.size());
+		std::iota(entries_order.begin(), entries_order.end(), size_t{0});
+		std::stable_sort(entries_order.begin(), entries_order.end(), [&lin_table_with_lines](size_t a, size_t b){
+			return lin_table_with_lines[a].lines.size() > lin_table_with_lines[b].lines.size();
+		});
+
+		std::vector<std::vector<VeldkampLineTableEntry>> entries_output(lin_table_with_lines.size());
+		std::vector<std::chrono::duration<double>> durations(lin_table_with_lines.size());
+		parallelTasks<Backend>(entries_order.size(), [&](size_t task){
+			const size_t i_entry = entries_order[task];
+			const auto start = std::chrono::steady_clock::now();
+			entries_output[i_entry] = separate(lin_table_with_lines[i_entry]);
+			durations[i_entry] = std::chrono::steady_clock::now() - start;
+		});
+
 		std::vector<VeldkampLineTableEntry> output_table;
-		for(const VeldkampLineTableEntryWithLines<NbrPointsPerLine>& lines_table_entry : lin_table_with_lines){
-			for(VeldkampLineTableEntry& entry : separateBy2StepsPermutations<Dimension, NbrPointsPerLine>(lines_table_entry, hyp_coord_permutations_table, hyp_dimension_permutations_table)){
-				output_table.push_back(std::move(entry));
-			}
+		for(std::vector<VeldkampLineTableEntry>& entry_output : entries_output){
+			std::move(entry_output.begin(), entry_output.end(), std::back_inserter(output_table));
+		}
+		if(entries_durations != nullptr){
+			*entries_durations = std::move(durations);
 		}
 		return output_table;
 	}
+
+	template<size_t Dimension, size_t NbrPointsPerLine, ParallelBackend Backend, size_t NbrPoints>
+	HyperplaneOrbits computeStabilizerOrbits(
+	  const SymmetryGroup<Dimension, NbrPointsPerLine>& group,
+	  const std::vector<std::bitset<NbrPoints>>& hyperplanes,
+	  const HyperplaneIndex<NbrPoints>& hyperplanes_index,
+	  unsigned int hyperplane
+	){
+		std::vector<std::vector<unsigned int>> stabilizer_actions;
+		for(const auto& generator : computeHyperplaneStabilizer<Dimension, NbrPointsPerLine>(hyperplanes[hyperplane]).generators){
+			const PointPermutation<NbrPoints> permutation = compilePermutation<Dimension, NbrPointsPerLine>(std::get<0>(generator), std::get<1>(generator));
+			std::vector<unsigned int> action(hyperplanes.size());
+			parallelChunks<Backend>(hyperplanes.size(), [&](size_t, size_t begin, size_t end){
+				for(size_t h = begin; h < end; ++h){
+					action[h] = hyperplanes_index.find(permuteHyperplane(hyperplanes[h], permutation));
+					if(action[h] == HyperplaneIndex<NbrPoints>::NOT_FOUND){
+						IMPOSSIBLE;
+					}
+				}
+			});
+			stabilizer_actions.push_back(std::move(action));
+		}
+		if(stabilizer_actions.empty()){
+			stabilizer_actions.emplace_back(hyperplanes.size());
+			std::iota(stabilizer_actions.back().begin(), stabilizer_actions.back().end(), 0U);
+		}
+		return group.computeOrbits(stabilizer_actions);
+	}
 }
 
 
@@ -4,13 +4,18 @@
 #include <algorithm>
 #include <vector>
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
 
 #include <nlohmann/json.hpp>
 #include <inja.hpp>
 
 #include "PointGeometry.hpp"
+#include "OutOfCoreHyperplanes.hpp"
 #include "LatexPrinter.hpp"
 #include "HyperplanesUtility.hpp"
+#include "LinearForms.hpp"
 #include "VeldkampLinesUtility.hpp"
 
 using json = nlohmann::json;
@@ -18,12 +23,53 @@ using json = nlohmann::json;
 constexpr size_t PPL = 4; // Points Per Lines
 constexpr bool COMPUTE_AND_PRINT_POINTS_ORDER = true;
 constexpr bool PRINT_SUBGEOMETRIES = true;
+constexpr segre::ParallelBackend PARALLEL_BACKEND = segre::ParallelBackend::Threads;
+constexpr bool CHECK_PROJECTIVE_LINES_WITH_LINEAR_FORMS = true;
+constexpr bool BENCHMARK_TILED_VELDKAMP_LINES = false; // Dimension 3 lines with and without tiles, under a minute
+constexpr bool CHECK_VELDKAMP_LINE_ORBITS = true; // Dimensions 2 and 3 lines tables from the lines orbits
+constexpr bool CHECK_DIMENSION3_LINES_CANONICAL_FORMS = false; // A canonical form search per line, about two minutes
+constexpr bool COMPUTE_DIMENSION4_LINES = false; // Out of core, restarts from its directory if interrupted
+const std::string DIMENSION4_LINES_DIRECTORY = "dimension4_lines";
+const std::string DIMENSION4_HYPERPLANES_CATALOG = "dimension4_hyperplanes";
+constexpr bool COMPUTE_DIMENSION5_HYPERPLANES = false; // Out of core, from the dimension 4 projective lines
+constexpr size_t DIMENSION5_HYPERPLANES_MEMORY_BUDGET = 4UL << 30U;
+const std::string DIMENSION5_HYPERPLANES_DIRECTORY = "dimension5_hyperplanes";
+
+static_assert(!COMPUTE_DIMENSION5_HYPERPLANES || COMPUTE_DIMENSION4_LINES, "The dimension 5 hyperplanes are computed after the dimension 4 lines");
 
 template<int N>
 using VPoints = std::vector<std::bitset<math::pow(PPL,N)>>;
 
-template<int>
-using VLines = segre::VeldkampLines<PPL>;
+using VLinesTable = segre::VeldkampLinesTable<PPL>;
+
+using HyperplaneId3 = std::uint16_t; // 3280 hyperplanes in dimension 3
+
+static bool sameLinesTables(std::vector<segre::VeldkampLineTableEntry> a, std::vector<segre::VeldkampLineTableEntry> b) {
+	const auto entry_order = [](const segre::VeldkampLineTableEntry& x, const segre::VeldkampLineTableEntry& y){
+		return std::tie(x.isProjective, x.coreNbrPoints, x.coreNbrLines, x.pointsType, x.count) < std::tie(y.isProjective, y.coreNbrPoints, y.coreNbrLines, y.pointsType, y.count);
+	};
+	std::sort(a.begin(), a.end(), entry_order);
+	std::sort(b.begin(), b.end(), entry_order);
+	return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const segre::VeldkampLineTableEntry& x, const segre::VeldkampLineTableEntry& y){
+		return x == y && x.count == y.count;
+	});
+}
+
+// Kept out of main: inlined into it, both lines searches are optimised worse and the timings are off
+[[gnu::noinline]] static bool benchmarkTiledVeldkampLines(const segre::PointGeometry<3, PPL, 48>& geometry, const VPoints<3>& vPoints) {
+	const auto lines_start = std::chrono::steady_clock::now();
+	const segre::VeldkampLines<PPL> vLines_pairs = geometry.computeVeldkampLines(vPoints);
+	const auto tiled_lines_start = std::chrono::steady_clock::now();
+	const segre::VeldkampLines<PPL> vLines_tiled = geometry.computeVeldkampLinesTiled(vPoints);
+	const auto tiled_lines_end = std::chrono::steady_clock::now();
+	if(vLines_pairs.exceptional != vLines_tiled.exceptional || vLines_pairs.projectives != vLines_tiled.projectives) {
+		std::cerr << "Dimension 3 tiled Veldkamp lines differ" << std::endl;
+		return false;
+	}
+	std::cout << "Dimension 3 Veldkamp lines: " << std::chrono::duration<double>(tiled_lines_start - lines_start).count() << "s, tiled: "
+	          << std::chrono::duration<double>(tiled_lines_end - tiled_lines_start).count() << "s\n" << std::endl;
+	return true;
+}
 
 int main() {
 	const auto time_start = std::chrono::system_clock::now();
@@ -37,77 +83,189 @@ int main() {
 	segre::PointGeometry<4, PPL, 256> geometry4(geometry3.computeCartesianProduct(), geometry3.buildTensorPoints());
 
 	VPoints<2> vPoints2 = geometry2.findHyperplanesByBruteforce(); // brut force
-	VLines<2> vLines2 = geometry2.computeVeldkampLines(vPoints2);
-	geometry2.distinguishVeldkampLines(vLines2, vPoints2, geometry3);
 
-	std::vector<segre::HyperplaneTableEntry> geometry2_hyp_table = geometry2.makeHyperplaneTable<COMPUTE_AND_PRINT_POINTS_ORDER>(vPoints2);
-	std::sort(geometry2_hyp_table.begin(), geometry2_hyp_table.end(), [] (const segre::HyperplaneTableEntry& a, const segre::HyperplaneTableEntry& b) {
+	segre::HyperplanesTable geometry2_hyp_table = geometry2.makeHyperplaneTable<COMPUTE_AND_PRINT_POINTS_ORDER, PARALLEL_BACKEND>(vPoints2);
+	segre::sortHyperplanesTable(geometry2_hyp_table, [] (const segre::HyperplaneTableEntry& a, const segre::HyperplaneTableEntry& b) {
 		return a.nbrPoints > b.nbrPoints;
 	});
-	std::vector<segre::VeldkampLineTableEntry> geometry2_lin_table = geometry2.makeVeldkampLinesTable(vLines2, vPoints2, geometry2_hyp_table);
+	const segre::HyperplaneIndex<math::pow(PPL,2)> vPoints2_index(vPoints2);
+
+	VLinesTable vLines2 = geometry2.computeVeldkampLinesTable<false>(vPoints2, geometry2_hyp_table.types, geometry3);
+	std::vector<segre::VeldkampLineTableEntry> geometry2_lin_table = vLines2.getEntries();
 	std::sort(geometry2_lin_table.begin(), geometry2_lin_table.end(), [](const segre::VeldkampLineTableEntry& a, const segre::VeldkampLineTableEntry& b){
 		return std::make_tuple(a.isProjective, a.coreNbrPoints, a.coreNbrLines) < std::make_tuple(b.isProjective, b.coreNbrPoints, b.coreNbrLines);
 	});
 
 	VPoints<3> vPoints3 = geometry2.computeHyperplanesFromVeldkampLines(vPoints2, vLines2.projectives);
-	VLines<3> vLines3 = geometry3.computeVeldkampLines(vPoints3);
-	geometry3.distinguishVeldkampLines(vLines3, vPoints3, geometry4);
 
-	std::vector<segre::HyperplaneTableEntry> geometry3_hyp_table = geometry3.makeHyperplaneTable<COMPUTE_AND_PRINT_POINTS_ORDER>(vPoints3, geometry2_hyp_table);
-	std::sort(geometry3_hyp_table.begin(), geometry3_hyp_table.end(), [] (const segre::HyperplaneTableEntry& a, const segre::HyperplaneTableEntry& b) {
+	segre::HyperplanesTable geometry3_hyp_table = geometry3.makeHyperplaneTable<COMPUTE_AND_PRINT_POINTS_ORDER, PARALLEL_BACKEND>(vPoints3, vPoints2_index, geometry2_hyp_table.types);
+	segre::sortHyperplanesTable(geometry3_hyp_table, [] (const segre::HyperplaneTableEntry& a, const segre::HyperplaneTableEntry& b) {
 		return a.nbrPoints > b.nbrPoints;
 	});
-	std::vector<segre::VeldkampLineTableEntry> geometry3_lin_table = geometry3.makeVeldkampLinesTable(vLines3, vPoints3, geometry3_hyp_table);
+	const segre::HyperplaneIndex<math::pow(PPL,3)> vPoints3_index(vPoints3);
+
+	VLinesTable vLines3 = geometry3.computeVeldkampLinesTable<true>(vPoints3, geometry3_hyp_table.types, geometry4);
+	std::vector<segre::VeldkampLineTableEntry> geometry3_lin_table = vLines3.getEntries();
 	std::sort(geometry3_lin_table.begin(), geometry3_lin_table.end(), [](const segre::VeldkampLineTableEntry& a, const segre::VeldkampLineTableEntry& b){
 		return std::make_tuple(a.isProjective, a.coreNbrPoints, a.coreNbrLines) < std::make_tuple(b.isProjective, b.coreNbrPoints, b.coreNbrLines);
 	});
 
-	std::vector<segre::VeldkampLineTableEntryWithLines<PPL>> geometry3_lin_table_with_lines = geometry3.makeVeldkampLinesTableWithLines(vLines3, vPoints3, geometry3_hyp_table);
+	if constexpr (CHECK_PROJECTIVE_LINES_WITH_LINEAR_FORMS) {
+		const std::vector<segre::LinearForm> vPoints3_forms = segre::computeLinearForms<PARALLEL_BACKEND>(geometry3, vPoints3);
+		const std::vector<std::array<unsigned int, PPL>> forms_projectives3 = segre::computeProjectiveLinesFromLinearForms<PPL, math::pow(2UL,3), PARALLEL_BACKEND>(vPoints3_forms, segre::LinearFormIndex(vPoints3_forms));
+
+		std::vector<std::array<unsigned int, PPL>> projectives3 = vLines3.projectives;
+		for(std::array<unsigned int, PPL>& line : projectives3) {
+			std::sort(line.begin(), line.end());
+		}
+		std::sort(projectives3.begin(), projectives3.end());
+		if(projectives3 != forms_projectives3) {
+			std::cerr << "Dimension 3 projective lines differ from the pencils of linear forms" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::vector<segre::VeldkampLineTableEntryWithLines<PPL>>& geometry3_lin_table_with_lines = vLines3.entries;
 	std::sort(geometry3_lin_table_with_lines.begin(), geometry3_lin_table_with_lines.end(), [](const segre::VeldkampLineTableEntryWithLines<PPL>& a, const segre::VeldkampLineTableEntryWithLines<PPL>& b){
 		return std::make_tuple(a.entry.isProjective, a.entry.coreNbrPoints, a.entry.coreNbrLines) < std::make_tuple(b.entry.isProjective, b.entry.coreNbrPoints, b.entry.coreNbrLines);
 	});
 
-	//std::vector<std::vector<unsigned int>> permutations_table = segre::makePermutationsTable<3, PPL>(vPoints3);
+	//segre::PermutationTable<HyperplaneId3> permutations_table = segre::makePermutationsTable<3, PPL, PARALLEL_BACKEND, HyperplaneId3>(vPoints3, vPoints3_index);
 	//std::vector<segre::VeldkampLineTableEntry> geometry3_lin_table_sep = segre::separateByPermutations<3,PPL>(geometry3_lin_table_with_lines, permutations_table);
 
-	std::vector<std::vector<unsigned int>> coord_permutation_table = segre::makeCoordPermutationsTable<3, PPL>(vPoints3);
-	std::vector<std::vector<unsigned int>> dimension_permutation_table = segre::makeDimensionPermutationsTable<3, PPL>(vPoints3);
-	std::vector<segre::VeldkampLineTableEntry> geometry3_lin_table_sep_2steps = segre::separateBy2StepsPermutations<3,PPL>(geometry3_lin_table_with_lines, coord_permutation_table, dimension_permutation_table);
+	//const segre::PermutationTable<HyperplaneId3> coord_permutation_table = segre::makeCoordPermutationsTable<3, PPL, PARALLEL_BACKEND, HyperplaneId3>(vPoints3, vPoints3_index);
+	//const segre::PermutationTable<HyperplaneId3> dimension_permutation_table = segre::makeDimensionPermutationsTable<3, PPL, PARALLEL_BACKEND, HyperplaneId3>(vPoints3, vPoints3_index);
+	//std::vector<segre::VeldkampLineTableEntry> geometry3_lin_table_sep_2steps = segre::separateBy2StepsPermutations<3, PPL, PARALLEL_BACKEND>(geometry3_lin_table_with_lines, coord_permutation_table, dimension_permutation_table);
+
+	std::vector<std::chrono::duration<double>> geometry3_lin_table_sep_durations;
+	std::vector<segre::VeldkampLineTableEntry> geometry3_lin_table_sep_orbits = segre::separateByGroupOrbits<3, PPL, PARALLEL_BACKEND>(geometry3_lin_table_with_lines, vPoints3, vPoints3_index, &geometry3_lin_table_sep_durations);
+
+	if constexpr (BENCHMARK_TILED_VELDKAMP_LINES) {
+		if(!benchmarkTiledVeldkampLines(geometry3, vPoints3)) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	if constexpr (CHECK_VELDKAMP_LINE_ORBITS) {
+		const std::vector<segre::VeldkampLineOrbit<PPL>> vLines2_orbits = segre::computeVeldkampLineOrbits<2, PPL, PARALLEL_BACKEND>(vPoints2, vPoints2_index);
+		if(!sameLinesTables(geometry2.makeVeldkampLinesTable(vLines2_orbits, vPoints2, geometry2_hyp_table.types, geometry3), geometry2_lin_table)) {
+			std::cerr << "Dimension 2 lines table from the lines orbits differs" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		const std::vector<segre::VeldkampLineOrbit<PPL>> vLines3_orbits = segre::computeVeldkampLineOrbits<3, PPL, PARALLEL_BACKEND>(vPoints3, vPoints3_index);
+		if(!sameLinesTables(geometry3.makeVeldkampLinesTable(vLines3_orbits, vPoints3, geometry3_hyp_table.types, geometry4), geometry3_lin_table)) {
+			std::cerr << "Dimension 3 lines table from the lines orbits differs" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::vector<std::array<unsigned int, PPL>> lines3;
+		for(const segre::VeldkampLineTableEntryWithLines<PPL>& entry : geometry3_lin_table_with_lines) {
+			lines3.insert(lines3.end(), entry.lines.begin(), entry.lines.end());
+		}
+		std::sort(lines3.begin(), lines3.end());
+		if(segre::expandVeldkampLineOrbits<3, PPL>(vLines3_orbits, vPoints3, vPoints3_index) != lines3) {
+			std::cerr << "Dimension 3 lines expanded from their orbits differ" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if constexpr (CHECK_DIMENSION3_LINES_CANONICAL_FORMS) {
+		const std::vector<segre::VeldkampLineTableEntry> geometry3_lin_table_sep_canonical = segre::separateByCanonicalForms<3, PPL, PARALLEL_BACKEND>(geometry3_lin_table_with_lines, vPoints3);
+		if(!sameLinesTables(geometry3_lin_table_sep_canonical, geometry3_lin_table_sep_orbits)) {
+			std::cerr << "Dimension 3 lines canonical forms differ from the group orbits" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
 
 	VPoints<4> vPoints4 = geometry3.computeHyperplanesFromVeldkampLines(vPoints3, vLines3.projectives);
-	std::vector<segre::HyperplaneTableEntry> geometry4_hyp_table = geometry4.makeHyperplaneTable<COMPUTE_AND_PRINT_POINTS_ORDER>(vPoints4, geometry3_hyp_table);
+	segre::HyperplanesTable geometry4_hyp_table = geometry4.makeHyperplaneTable<COMPUTE_AND_PRINT_POINTS_ORDER, PARALLEL_BACKEND>(vPoints4, vPoints3_index, geometry3_hyp_table.types);
 
-	std::sort(geometry4_hyp_table.begin(), geometry4_hyp_table.end(), [] (const segre::HyperplaneTableEntry& a, const segre::HyperplaneTableEntry& b) {
+	segre::sortHyperplanesTable(geometry4_hyp_table, [] (const segre::HyperplaneTableEntry& a, const segre::HyperplaneTableEntry& b) {
 		return a.nbrPoints > b.nbrPoints;
 	});
 
+	std::vector<segre::VeldkampLineTableEntry> geometry4_lin_table;
+	size_t nbr_hyperplanes5 = 0;
+	segre::HyperplanesTable geometry5_hyp_table;
+	if constexpr (COMPUTE_DIMENSION4_LINES) {
+		// Too large for the stack
+		const auto geometry5 = std::make_unique<segre::PointGeometry<5, PPL, 1280>>(geometry4.computeCartesianProduct(), geometry4.buildTensorPoints());
+
+		const segre::HyperplaneIndex<math::pow(PPL,4)> vPoints4_index(vPoints4);
+		if(!segre::computeVeldkampLinesTableOutOfCore<4, PPL, PARALLEL_BACKEND>(geometry4, vPoints4, vPoints4_index, geometry4_hyp_table.types, *geometry5, DIMENSION4_LINES_DIRECTORY, geometry4_lin_table)) {
+			return EXIT_FAILURE;
+		}
+		std::sort(geometry4_lin_table.begin(), geometry4_lin_table.end(), [](const segre::VeldkampLineTableEntry& a, const segre::VeldkampLineTableEntry& b){
+			return std::make_tuple(a.isProjective, a.coreNbrPoints, a.coreNbrLines) < std::make_tuple(b.isProjective, b.coreNbrPoints, b.coreNbrLines);
+		});
+
+		if constexpr (COMPUTE_DIMENSION5_HYPERPLANES) {
+			const std::vector<segre::LinearForm> vPoints4_forms = segre::computeLinearForms<PARALLEL_BACKEND>(geometry4, vPoints4);
+			segre::HyperplaneCatalog<math::pow(PPL,4)> vPoints4_catalog;
+			if(!segre::writeProjectiveLinesFromLinearForms(geometry4, vPoints4, geometry4_hyp_table.types, vPoints4_forms, segre::LinearFormIndex(vPoints4_forms), DIMENSION4_LINES_DIRECTORY + "/projectives")
+			   || !segre::HyperplaneCatalog<math::pow(PPL,4)>::save(DIMENSION4_HYPERPLANES_CATALOG, vPoints4)
+			   || !vPoints4_catalog.open(DIMENSION4_HYPERPLANES_CATALOG)
+			   || !segre::computeHyperplanesTableOutOfCore<COMPUTE_AND_PRINT_POINTS_ORDER, PARALLEL_BACKEND>(*geometry5, vPoints4_catalog, DIMENSION4_LINES_DIRECTORY + "/projectives", vPoints4_index, geometry4_hyp_table.types, segre::OutOfCoreOptions(DIMENSION5_HYPERPLANES_DIRECTORY, DIMENSION5_HYPERPLANES_MEMORY_BUDGET), nbr_hyperplanes5, geometry5_hyp_table)) {
+				return EXIT_FAILURE;
+			}
+			if(!segre::sortHyperplanesTableOutOfCore(geometry5_hyp_table, DIMENSION5_HYPERPLANES_DIRECTORY, [] (const segre::HyperplaneTableEntry& a, const segre::HyperplaneTableEntry& b) {
+				return a.nbrPoints > b.nbrPoints;
+			})) {
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
 	const auto time_end = std::chrono::system_clock::now();
 	const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(time_end - time_start);
 	std::cout << "Finished in " << static_cast<int>(elapsed.count()) << " seconds\n" << std::endl;
 
 	std::cout << "\nDimension 2 points:\n";
-	std::copy(geometry2_hyp_table.begin(), geometry2_hyp_table.end(), std::ostream_iterator<segre::HyperplaneTableEntry>(std::cout, "\n"));
+	std::copy(geometry2_hyp_table.entries.begin(), geometry2_hyp_table.entries.end(), std::ostream_iterator<segre::HyperplaneTableEntry>(std::cout, "\n"));
 
 	std::cout << "\nDimension 2 lines:\n";
 	std::copy(geometry2_lin_table.begin(), geometry2_lin_table.end(), std::ostream_iterator<segre::VeldkampLineTableEntry>(std::cout, "\n"));
 
 	std::cout << "\nDimension 3 points:\n";
-	std::copy(geometry3_hyp_table.begin(), geometry3_hyp_table.end(), std::ostream_iterator<segre::HyperplaneTableEntry>(std::cout, "\n"));
+	std::copy(geometry3_hyp_table.entries.begin(), geometry3_hyp_table.entries.end(), std::ostream_iterator<segre::HyperplaneTableEntry>(std::cout, "\n"));
 
 	std::cout << "\nDimension 3 lines:\n";
 	std::copy(geometry3_lin_table.begin(), geometry3_lin_table.end(), std::ostream_iterator<segre::VeldkampLineTableEntry>(std::cout, "\n"));
 
 	std::cout << "\nDimension 4 points:\n";
-	std::copy(geometry4_hyp_table.begin(), geometry4_hyp_table.end(), std::ostream_iterator<segre::HyperplaneTableEntry>(std::cout, "\n"));
+	std::copy(geometry4_hyp_table.entries.begin(), geometry4_hyp_table.entries.end(), std::ostream_iterator<segre::HyperplaneTableEntry>(std::cout, "\n"));
+
+	if constexpr (COMPUTE_DIMENSION4_LINES) {
+		std::cout << "\nDimension 4 lines:\n";
+		std::copy(geometry4_lin_table.begin(), geometry4_lin_table.end(), std::ostream_iterator<segre::VeldkampLineTableEntry>(std::cout, "\n"));
+	}
+
+	if constexpr (COMPUTE_DIMENSION5_HYPERPLANES) {
+		std::cout << "\nDimension 5 points (" << nbr_hyperplanes5 << " hyperplanes):\n";
+		std::copy(geometry5_hyp_table.entries.begin(), geometry5_hyp_table.entries.end(), std::ostream_iterator<segre::HyperplaneTableEntry>(std::cout, "\n"));
+	}
+
+	std::cout << "\nDimension 3 lines separation time per entry:\n";
+	for(size_t i = 0; i < geometry3_lin_table_with_lines.size(); ++i) {
+		std::cout << geometry3_lin_table_with_lines[i].entry << " -> " << geometry3_lin_table_sep_durations[i].count() << "s\n";
+	}
 
 	LatexPrinter printer;
-	printer.generateHyperplanesTable<COMPUTE_AND_PRINT_POINTS_ORDER,PRINT_SUBGEOMETRIES>(2, geometry2_hyp_table, 0);
-	printer.generateLinesTable(2, geometry2_lin_table, geometry2_hyp_table.size());
-	printer.generateHyperplanesTable<COMPUTE_AND_PRINT_POINTS_ORDER,PRINT_SUBGEOMETRIES>(3, geometry3_hyp_table, geometry2_hyp_table.size());
-	printer.generateLinesTable(3, geometry3_lin_table, geometry3_hyp_table.size());
-	//printer.generateLinesDiffTable(3, geometry3_lin_table, geometry3_lin_table_sep, geometry3_hyp_table.size());
-	printer.generateLinesDiffTable(3, geometry3_lin_table, geometry3_lin_table_sep_2steps, geometry3_hyp_table.size());
-	printer.generateHyperplanesTable<COMPUTE_AND_PRINT_POINTS_ORDER,PRINT_SUBGEOMETRIES>(4, geometry4_hyp_table, geometry3_hyp_table.size());
+	printer.generateHyperplanesTable<COMPUTE_AND_PRINT_POINTS_ORDER,PRINT_SUBGEOMETRIES>(2, geometry2_hyp_table.entries, 0);
+	printer.generateLinesTable(2, geometry2_lin_table, geometry2_hyp_table.entries.size());
+	printer.generateHyperplanesTable<COMPUTE_AND_PRINT_POINTS_ORDER,PRINT_SUBGEOMETRIES>(3, geometry3_hyp_table.entries, geometry2_hyp_table.entries.size());
+	printer.generateLinesTable(3, geometry3_lin_table, geometry3_hyp_table.entries.size());
+	//printer.generateLinesDiffTable(3, geometry3_lin_table, geometry3_lin_table_sep, geometry3_hyp_table.entries.size());
+	//printer.generateLinesDiffTable(3, geometry3_lin_table, geometry3_lin_table_sep_2steps, geometry3_hyp_table.entries.size());
+	printer.generateLinesDiffTable(3, geometry3_lin_table, geometry3_lin_table_sep_orbits, geometry3_hyp_table.entries.size());
+	printer.generateHyperplanesTable<COMPUTE_AND_PRINT_POINTS_ORDER,PRINT_SUBGEOMETRIES>(4, geometry4_hyp_table.entries, geometry3_hyp_table.entries.size());
+	if constexpr (COMPUTE_DIMENSION4_LINES) {
+		printer.generateLinesTable(4, geometry4_lin_table, geometry4_hyp_table.entries.size());
+	}
+	if constexpr (COMPUTE_DIMENSION5_HYPERPLANES) {
+		printer.generateHyperplanesTable<COMPUTE_AND_PRINT_POINTS_ORDER,PRINT_SUBGEOMETRIES>(5, geometry5_hyp_table.entries, geometry4_hyp_table.entries.size());
+	}
 
 	return EXIT_SUCCESS;
 }
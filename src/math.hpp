@@ -11,6 +11,12 @@ namespace math {
 		return exponent == 0 ? 1 : base * pow(base, exponent - 1);
 	}
 
+	template <typename T>
+	inline constexpr T bitWidth(T value) {
+		static_assert(std::is_integral_v<T>);
+		return value == 0 ? 0 : 1 + bitWidth(static_cast<T>(value / 2));
+	}
+
 	template<unsigned int val>
 	constexpr unsigned int facorial = val * facorial<val - 1>;
 